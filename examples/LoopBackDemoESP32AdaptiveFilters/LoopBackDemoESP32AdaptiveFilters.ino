@@ -0,0 +1,130 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Adaptive Filter Placement Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   RECEIVE FUNCTIONS
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gDiagnosticCount = 0 ;
+static uint32_t gNodeFrameCount = 0 ;
+
+static void receiveDiagnostic (const CANMessage & inMessage) {
+  gDiagnosticCount += 1 ;
+}
+
+static void receiveNodeFrame (const CANMessage & inMessage) {
+  gNodeFrameCount += 1 ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+  settings.mSoftwareFrameFilterCapacity = 64 ;
+//----------------------------------- Static filter #0; filters #1 ... #31 are placed by the driver
+  ACAN2517Filters staticFilters ;
+  staticFilters.appendFrameFilter (kStandard, 0x7DF, receiveDiagnostic) ;
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }, staticFilters) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- 64 identifiers: more than the remaining 31 hardware filters
+  for (uint32_t i = 0 ; i < 64 ; i++) {
+    can.appendSoftwareFrameFilter (kStandard, 0x400 + 3 * i, receiveNodeFrame) ;
+  }
+//--- Filters #1 ... #31, 16 exact filters for the most received identifiers, rebalanced every 2 s
+  if (!can.setAdaptiveFilterPlacement (1, 16, 2000)) {
+    Serial.println ("setAdaptiveFilterPlacement error") ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gSendDate = 0 ;
+static uint32_t gReportDate = 0 ;
+static uint32_t gIndex = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+//--- Hot identifiers change every 10 s; every other frame is a random identifier (mostly unwanted)
+  if (gSendDate < millis ()) {
+    gSendDate += 2 ;
+    CANMessage frame ;
+    if ((gIndex & 1) != 0) {
+      frame.id = 0x400 + (uint32_t) random (0x100) ;
+    }else{
+      const uint32_t hotBase = (millis () / 10000) % 4 ;
+      frame.id = 0x400 + 3 * (16 * hotBase + (gIndex / 2) % 16) ;
+    }
+    gIndex += 1 ;
+    can.tryToSend (frame) ;
+  }
+  can.dispatchAll (16) ;
+//--- Placement is computed here, never by the interrupt service routine
+  if (can.updateFilterPlacement ()) {
+    Serial.println ("Filters rebalanced") ;
+  }
+  if (gReportDate < millis ()) {
+    gReportDate += 2000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    Serial.print ("Node frames: ") ;
+    Serial.print (gNodeFrameCount) ;
+    Serial.print (", unwanted frames read over SPI: ") ;
+    Serial.println (can.softwareRejectedFrameCount ()) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
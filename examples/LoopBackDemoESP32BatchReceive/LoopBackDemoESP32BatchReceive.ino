@@ -0,0 +1,117 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Batch Reception Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   RECEIVE FUNCTION
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gDispatchedCount = 0 ;
+
+static void receiveFrame (const CANMessage & inMessage) {
+  gDispatchedCount += 1 ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+  settings.mDriverReceiveFIFOSize = 64 ;
+//----------------------------------- Filter #0: 0x100 ... 0x1FF, dispatched by dispatchAll; other frames
+//                                    are read by receiveBatch
+  ACAN2517Filters filters ;
+  filters.appendFilter (kStandard, 0x700, 0x100, receiveFrame) ;
+  filters.appendPassAllFilter (NULL) ; // Filter #1
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }, filters) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+//--- A burst of 32 frames is sent every second: even seconds 0x1xx, odd seconds 0x2xx
+
+static uint32_t gSendDate = 0 ;
+static uint32_t gSecond = 0 ;
+static uint32_t gBatchCount = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gSendDate < millis ()) {
+    gSendDate += 1000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    for (uint32_t i = 0 ; i < 32 ; i++) {
+      CANMessage frame ;
+      frame.id = (((gSecond & 1) == 0) ? 0x100 : 0x200) + i ;
+      can.tryToSend (frame) ;
+    }
+    gSecond += 1 ;
+    Serial.print ("Dispatched: ") ;
+    Serial.print (gDispatchedCount) ;
+    Serial.print (", received by batch: ") ;
+    Serial.println (gBatchCount) ;
+  }
+  if ((gSecond & 1) != 0) {
+  //--- At most 64 messages, at most 500 µs; the receive lock is taken once per contiguous span
+    can.dispatchAll (64, 500) ;
+  }else{
+  //--- One lock for the batch
+    CANMessage frames [16] ;
+    gBatchCount += can.receiveBatch (frames, 16) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
@@ -0,0 +1,111 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Blocking Receive and Send Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   CONSUMER TASK
+//——————————————————————————————————————————————————————————————————————————————
+
+//--- receive with a time out: the task sleeps until the driver handler task has received a frame
+
+static void consumerTask (void * inData) {
+  uint32_t receivedCount = 0 ;
+  while (true) {
+    CANMessage frame ;
+    if (can.receive (frame, 1000)) { // Waits at most 1000 ms
+      receivedCount += 1 ;
+      Serial.print ("Received: ") ;
+      Serial.println (receivedCount) ;
+    }else{
+      Serial.println ("Nothing received within 1 s") ;
+    }
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- Start consumer task
+  xTaskCreate (consumerTask, "Consumer", 4096, NULL, 1, NULL) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+//--- Bursts of 4 frames every 500 ms during 10 s, then a 3 s pause
+
+static uint32_t gSendDate = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gSendDate < millis ()) {
+    gSendDate += 500 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    const uint8_t frameCount = ((millis () % 13000) < 10000) ? 4 : 0 ;
+    for (uint8_t i = 0 ; i < frameCount ; i++) {
+      CANMessage frame ;
+      frame.id = 0x100 + i ;
+      if (!can.send (frame, 10)) { // Waits at most 10 ms for room in the driver transmit buffer
+        Serial.println ("Send time out") ;
+      }
+    }
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
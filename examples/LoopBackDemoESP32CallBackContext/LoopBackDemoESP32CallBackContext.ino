@@ -0,0 +1,128 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Call Back with Context Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   NODE OBJECTS, GIVEN AS CALL BACK CONTEXT
+//——————————————————————————————————————————————————————————————————————————————
+
+class Node {
+  public: Node (const char * inName) : mName (inName) {}
+  public: void handle (const CANMessage & inMessage) {
+    mFrameCount += 1 ;
+    Serial.print (mName) ;
+    Serial.print (": ") ;
+    Serial.println (mFrameCount) ;
+  }
+  private: const char * mName ;
+  private: uint32_t mFrameCount = 0 ;
+} ;
+
+static Node gNodeA ("Node A") ;
+static Node gNodeB ("Node B") ;
+
+static void receiveNodeFrame (const CANMessage & inMessage, void * inContext) {
+  static_cast <Node *> (inContext)->handle (inMessage) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+//----------------------------------- Filters without call back: handlers are set below
+  ACAN2517Filters filters ;
+  filters.appendFrameFilter (kStandard, 0x200, NULL) ; // Filter #0: handler table
+  filters.appendFrameFilter (kStandard, 0x100, NULL) ; // Filter #1: node A
+  filters.appendFrameFilter (kStandard, 0x101, NULL) ; // Filter #2: node B
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }, filters) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- Call backs with context are set after begin
+  can.setFilterCallBack (1, receiveNodeFrame, & gNodeA) ;
+  can.setFilterCallBack (2, receiveNodeFrame, & gNodeB) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gSendDate = 0 ;
+static uint8_t gPhase = 0 ;
+static uint32_t gTableFrameCount = 0 ;
+
+//--- One handler per filter index, from filter #0; handler types are template arguments, calls can be
+//    inlined. A filter without handler (here, #1 and #2) goes to its call back, with context
+static auto gHandlers = makeHandlerTable (
+  [] (const CANMessage & inMessage) { gTableFrameCount += 1 ; } // Filter #0
+) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gSendDate < millis ()) {
+    gSendDate += 1000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    CANMessage frame ;
+    frame.id = (gPhase == 0) ? 0x100 : ((gPhase == 1) ? 0x101 : 0x200) ;
+    gPhase = (gPhase + 1) % 3 ;
+    can.tryToSend (frame) ;
+  }
+  const uint32_t tableFrameCount = gTableFrameCount ;
+  can.dispatchReceivedMessage (gHandlers) ;
+  if (tableFrameCount != gTableFrameCount) {
+    Serial.print ("Handler table: ") ;
+    Serial.println (gTableFrameCount) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
@@ -0,0 +1,106 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Change Only Delivery Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+  settings.mChangeOnlyCapacity = 4 ; // Maximum number of registered identifiers
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- Repeated frames are dropped by the driver
+  can.deliverOnChange (kStandard, 0x3A0) ; // Never refreshed
+  can.deliverOnChange (kStandard, 0x3A1, 2000) ; // Unchanged frame delivered every 2 s
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+//--- Both frames are sent every 50 ms; their value changes every 5 s
+
+static uint32_t gSendDate = 0 ;
+static uint32_t gReportDate = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gSendDate < millis ()) {
+    gSendDate += 50 ;
+    CANMessage frame ;
+    frame.len = 1 ;
+    frame.data [0] = (uint8_t) (millis () / 5000) ;
+    frame.id = 0x3A0 ;
+    can.tryToSend (frame) ;
+    frame.id = 0x3A1 ;
+    can.tryToSend (frame) ;
+  }
+  CANMessage frame ;
+  if (can.receive (frame)) {
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    Serial.print (millis ()) ;
+    Serial.print (" ms: 0x") ;
+    Serial.print (frame.id, HEX) ;
+    Serial.print (", value ") ;
+    Serial.println (frame.data [0]) ;
+  }
+  if (gReportDate < millis ()) {
+    gReportDate += 10000 ;
+    Serial.print ("Unchanged frames dropped: ") ;
+    Serial.println (can.unchangedFrameCount ()) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
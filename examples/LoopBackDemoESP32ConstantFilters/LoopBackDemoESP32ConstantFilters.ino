@@ -0,0 +1,125 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Constant Filter Table Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   RECEIVE FUNCTIONS
+//——————————————————————————————————————————————————————————————————————————————
+
+static void receiveFromFilter0 (const CANMessage & inMessage) {
+  Serial.println ("Match filter 0") ;
+}
+
+static void receiveFromFilter1 (const CANMessage & inMessage) {
+  Serial.println ("Match filter 1") ;
+}
+
+static void receiveFromFilter2 (const CANMessage & inMessage) {
+  Serial.println ("Match filter 2") ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   CONSTANT FILTER TABLE (computed at compile time, not copied, no heap allocation)
+//——————————————————————————————————————————————————————————————————————————————
+
+static constexpr ACAN2517ConstantFilter filters [] = {
+  ACAN2517ConstantFilter::frameFilter (kStandard, 0x123, receiveFromFilter0), // Filter #0
+  ACAN2517ConstantFilter::frameFilter (kExtended, 0x12345678, receiveFromFilter1), // Filter #1
+  ACAN2517ConstantFilter::filter (kStandard, 0x70F, 0x304, receiveFromFilter2) // Filter #2: 0x3n4
+} ;
+
+static_assert (ACAN2517ConstantFilter::isValidTable (filters), "Invalid filter definition") ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }, filters) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gSendDate = 0 ;
+static uint8_t gPhase = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gSendDate < millis ()) {
+    gSendDate += 2000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    CANMessage frame ;
+    if (gPhase == 0) {
+      frame.id = 0x123 ; // Will match filter #0
+    }else if (gPhase == 1) {
+      frame.ext = true ;
+      frame.id = 0x12345678 ; // Will match filter #1
+    }else{
+      frame.id = 0x334 ; // Will match filter #2
+    }
+    if (can.tryToSend (frame)) {
+      Serial.print ("Sent for filter ") ;
+      Serial.println (gPhase) ;
+      gPhase = (gPhase + 1) % 3 ;
+    }else{
+      Serial.println ("Send failure") ;
+    }
+  }
+  can.dispatchReceivedMessage () ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
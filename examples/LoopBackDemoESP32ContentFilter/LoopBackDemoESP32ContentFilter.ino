@@ -0,0 +1,105 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Content Filter Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+  settings.mContentFilterCapacity = 4 ; // Maximum number of rules
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- Keep only multiplexer values 3 and 5 (byte 0) of frame 0x320
+  can.appendContentFilter (kStandard, 0x7FF, 0x320, 0xFF, 0x03) ; // Data byte i is bits 8*i ... 8*i+7 of data64
+  can.appendContentFilter (kStandard, 0x7FF, 0x320, 0xFF, 0x05) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gSendDate = 0 ;
+static uint8_t gMultiplexer = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+//--- 0x320 with multiplexer 0 ... 7, and 0x321 (no rule: not affected)
+  if (gSendDate < millis ()) {
+    gSendDate += 250 ;
+    CANMessage frame ;
+    frame.id = 0x320 ;
+    frame.len = 2 ;
+    frame.data [0] = gMultiplexer ;
+    frame.data [1] = 0x55 ;
+    can.tryToSend (frame) ;
+    if (gMultiplexer == 0) {
+      frame.id = 0x321 ;
+      can.tryToSend (frame) ;
+    }
+    gMultiplexer = (gMultiplexer + 1) % 8 ;
+  }
+  CANMessage frame ;
+  if (can.receive (frame)) {
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    Serial.print ("Received 0x") ;
+    Serial.print (frame.id, HEX) ;
+    Serial.print (", multiplexer ") ;
+    Serial.print (frame.data [0]) ;
+    Serial.print (", rejected: ") ;
+    Serial.println (can.contentRejectedFrameCount ()) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
@@ -0,0 +1,142 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Coroutine Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517Coroutines.h> // Requires a C++20 compiler (Arduino ESP32 3.x)
+#include <SPI.h>
+
+#ifndef __cpp_impl_coroutine
+  #error "Coroutines are not supported by this compiler"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   COROUTINE SCHEDULER
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517CoroutineScheduler scheduler (can) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SERVER: answers every request (0x542) with 0x543, written as sequential code
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517Task server (void) {
+  CANMessage request ;
+  while (co_await scheduler.nextFrame (request, 0, 0)) { // Filter #0, no time out
+    CANMessage answer ;
+    answer.id = 0x543 ;
+    answer.len = 1 ;
+    answer.data [0] = (uint8_t) (request.data [0] + 1) ;
+    if (!co_await scheduler.sendConfirmed (answer, 10)) {
+      Serial.println ("Server: answer not confirmed") ;
+    }
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   CLIENT: sends a request, waits for its transmission, then for the answer
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517Task client (const uint8_t inValue) {
+  CANMessage request ;
+  request.id = 0x542 ;
+  request.len = 1 ;
+  request.data [0] = inValue ;
+  if (!co_await scheduler.sendConfirmed (request)) { // Default time out
+    Serial.println ("Client: request not confirmed") ;
+  }else{
+    CANMessage answer ;
+    if (co_await scheduler.nextFrame (answer, 1, 100)) { // Filter #1, 100 ms time out
+      Serial.print ("Client: sent ") ;
+      Serial.print (inValue) ;
+      Serial.print (", answer ") ;
+      Serial.println (answer.data [0]) ;
+    }else{
+      Serial.println ("Client: no answer") ;
+    }
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+//----------------------------------- Filters: frames are handed to the coroutines by filter index
+  ACAN2517Filters filters ;
+  filters.appendFrameFilter (kStandard, 0x542, NULL) ; // Filter #0: requests
+  filters.appendFrameFilter (kStandard, 0x543, NULL) ; // Filter #1: answers
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }, filters) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- Start server: it runs until its first co_await
+  server () ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gClientDate = 0 ;
+static uint8_t gValue = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+//--- A new client coroutine every second; its frame is destroyed when it returns
+  if (gClientDate < millis ()) {
+    gClientDate += 1000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    client (gValue) ;
+    gValue += 1 ;
+  }
+//--- Resumes the coroutines whose frame has been received, or whose message has been sent or timed out
+  scheduler.run () ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
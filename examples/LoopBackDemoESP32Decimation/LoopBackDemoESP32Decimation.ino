@@ -0,0 +1,107 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Receive Decimation Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+  settings.mDecimationCapacity = 4 ; // Maximum number of registered identifiers
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- High rate frames are decimated by the driver
+  can.decimateFrame (kStandard, 0x0A0, 10) ; // Keep one frame out of 10
+  can.limitFrameRate (kStandard, 0x0A1, 500 * 1000) ; // At most one frame every 500 ms
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+//--- 0x0A0, 0x0A1 and 0x0A2 (not decimated) are sent every 20 ms
+
+static uint32_t gSendDate = 0 ;
+static uint32_t gReportDate = 0 ;
+static uint32_t gReceivedCount [3] = {0, 0, 0} ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gSendDate < millis ()) {
+    gSendDate += 20 ;
+    for (uint32_t identifier = 0x0A0 ; identifier <= 0x0A2 ; identifier++) {
+      CANMessage frame ;
+      frame.id = identifier ;
+      can.tryToSend (frame) ;
+    }
+  }
+  CANMessage frame ;
+  if (can.receive (frame) && (frame.id >= 0x0A0) && (frame.id <= 0x0A2)) {
+    gReceivedCount [frame.id - 0x0A0] += 1 ;
+  }
+  if (gReportDate < millis ()) {
+    gReportDate += 2000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    Serial.print ("0x0A0: ") ;
+    Serial.print (gReceivedCount [0]) ;
+    Serial.print (", 0x0A1: ") ;
+    Serial.print (gReceivedCount [1]) ;
+    Serial.print (", 0x0A2: ") ;
+    Serial.print (gReceivedCount [2]) ;
+    Serial.print (", decimated: ") ;
+    Serial.println (can.decimatedFrameCount ()) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
@@ -0,0 +1,111 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Deferred Decoding Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+//--- Message objects are copied as read from SPI by the interrupt service routine, and decoded by receive
+  settings.mDeferredReceiveDecoding = true ;
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gSendDate = 0 ;
+static uint32_t gReportDate = 0 ;
+static uint32_t gReceivedCount = 0 ;
+static uint32_t gErrorCount = 0 ;
+static uint32_t gCounter = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+//--- Standard and extended frames, with a counter in data32 [0]
+  if (gSendDate < millis ()) {
+    gSendDate += 5 ;
+    CANMessage frame ;
+    frame.ext = (gCounter & 1) != 0 ;
+    frame.id = frame.ext ? (0x12345678 + gCounter) : (gCounter & 0x7FF) ;
+    frame.len = 4 ;
+    frame.data32 [0] = gCounter ;
+    if (can.tryToSend (frame)) {
+      gCounter += 1 ;
+    }
+  }
+//--- Decoding is done here
+  CANMessage frame ;
+  if (can.receive (frame)) {
+    const uint32_t counter = frame.data32 [0] ;
+    const uint32_t identifier = frame.ext ? (0x12345678 + counter) : (counter & 0x7FF) ;
+    if ((frame.id != identifier) || (frame.ext != ((counter & 1) != 0)) || (frame.len != 4)) {
+      gErrorCount += 1 ;
+    }
+    gReceivedCount += 1 ;
+  }
+  if (gReportDate < millis ()) {
+    gReportDate += 2000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    Serial.print ("Received: ") ;
+    Serial.print (gReceivedCount) ;
+    Serial.print (", decoding errors: ") ;
+    Serial.println (gErrorCount) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
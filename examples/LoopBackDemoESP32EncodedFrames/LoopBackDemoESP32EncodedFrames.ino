@@ -0,0 +1,119 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Pre-Encoded Frame Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   PRE-ENCODED FRAMES
+//——————————————————————————————————————————————————————————————————————————————
+
+//--- Encoded at compile time: sending is a plain copy into the SPI buffer
+static constexpr ACAN2517EncodedFrame kHeartbeat (kStandard, 0x700, 1, 0x05) ;
+static constexpr ACAN2517EncodedFrame kStatus (kExtended, 0x18FEF100, 2, 0x3412) ;
+
+//--- Encoded at run time, once; only data bytes are changed afterwards
+static ACAN2517EncodedFrame gCounter ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- Encode counter frame
+  CANMessage counter ;
+  counter.id = 0x123 ;
+  counter.len = 1 ;
+  gCounter = ACAN2517EncodedFrame (counter) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gSendDate = 0 ;
+static uint8_t gPhase = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gSendDate < millis ()) {
+    gSendDate += 1000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    bool ok = false ;
+    if (gPhase == 0) {
+      ok = can.tryToSend (kHeartbeat) ;
+    }else if (gPhase == 1) {
+      ok = can.tryToSend (kStatus) ;
+    }else{
+      gCounter.setData (0, (uint8_t) (gCounter.data (0) + 1)) ;
+      ok = can.tryToSend (gCounter) ;
+    }
+    gPhase = (gPhase + 1) % 3 ;
+    if (!ok) {
+      Serial.println ("Send failure") ;
+    }
+  }
+  CANMessage frame ;
+  if (can.receive (frame)) {
+    Serial.print ("Received ") ;
+    Serial.print (frame.ext ? "extended 0x" : "standard 0x") ;
+    Serial.print (frame.id, HEX) ;
+    Serial.print (", length ") ;
+    Serial.print (frame.len) ;
+    Serial.print (", data [0]: 0x") ;
+    Serial.println (frame.data [0], HEX) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
@@ -0,0 +1,136 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Filter Compiler Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   WANTED IDENTIFIERS
+//——————————————————————————————————————————————————————————————————————————————
+
+static bool isWanted (const CANMessage & inMessage) {
+  return (inMessage.id == 0x123)
+    || (inMessage.id == 0x245)
+    || ((inMessage.id >= 0x300) && (inMessage.id <= 0x3A7)) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   RECEIVE FUNCTION
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gWantedCount = 0 ;
+static uint32_t gUnwantedCount = 0 ;
+
+static void receiveFrame (const CANMessage & inMessage) {
+  if (isWanted (inMessage)) {
+    gWantedCount += 1 ;
+  }else{
+    gUnwantedCount += 1 ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+//----------------------------------- Compile wanted identifiers into at most 4 filters
+  ACAN2517FilterCompiler compiler (64) ; // Capacity: identifiers and aligned blocks
+  compiler.appendFrame (kStandard, 0x123) ;
+  compiler.appendFrame (kStandard, 0x245) ;
+  compiler.appendRange (kStandard, 0x300, 0x3A7) ;
+  compiler.compile (4) ;
+  ACAN2517Filters filters ;
+  compiler.appendFiltersTo (filters, receiveFrame) ;
+  Serial.print ("Filters: ") ;
+  Serial.print (compiler.filterCount ()) ;
+  Serial.print (", wanted: ") ;
+  Serial.print (compiler.wantedCount ()) ;
+  Serial.print (", admitted: ") ;
+  Serial.print (compiler.admittedCount ()) ;
+  Serial.print (", false positive fraction: ") ;
+  Serial.println (compiler.falsePositiveFraction ()) ;
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }, filters) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gSendDate = 0 ;
+static uint32_t gReportDate = 0 ;
+static uint32_t gIdentifier = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gSendDate < millis ()) {
+    gSendDate += 5 ;
+  //--- Sweep all standard identifiers
+    CANMessage frame ;
+    frame.id = gIdentifier ;
+    if (can.tryToSend (frame)) {
+      gIdentifier = (gIdentifier + 1) & 0x7FF ;
+    }
+  }
+  can.dispatchReceivedMessage () ;
+  if (gReportDate < millis ()) {
+    gReportDate += 2000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    Serial.print ("Wanted frames: ") ;
+    Serial.print (gWantedCount) ;
+    Serial.print (", unwanted frames: ") ;
+    Serial.println (gUnwantedCount) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
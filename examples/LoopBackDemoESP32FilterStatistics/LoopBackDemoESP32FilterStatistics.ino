@@ -0,0 +1,126 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Filter Statistics Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   RECEIVE FUNCTION
+//——————————————————————————————————————————————————————————————————————————————
+
+static void receiveFrame (const CANMessage & inMessage) {
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+  settings.mFilterStatistics = true ; // Frames and bytes accepted by every hardware filter
+//----------------------------------- Filters
+  ACAN2517Filters filters ;
+  filters.appendFrameFilter (kStandard, 0x100, receiveFrame) ; // Filter #0
+  filters.appendFrameFilter (kStandard, 0x200, receiveFrame) ; // Filter #1
+  filters.appendFilter (kStandard, 0x700, 0x300, receiveFrame) ; // Filter #2: 0x300 ... 0x3FF
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }, filters) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gSendDate = 0 ;
+static uint32_t gReportDate = 0 ;
+static uint32_t gIndex = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+//--- Traffic profile: 0x100 (8 bytes) is sent 5 times more than 0x200 (2 bytes), 0x3xx (1 byte) twice more
+  if (gSendDate < millis ()) {
+    gSendDate += 10 ;
+    CANMessage frame ;
+    const uint32_t phase = gIndex % 8 ;
+    if (phase < 5) {
+      frame.id = 0x100 ;
+      frame.len = 8 ;
+    }else if (phase == 5) {
+      frame.id = 0x200 ;
+      frame.len = 2 ;
+    }else{
+      frame.id = 0x300 + (gIndex & 0xFF) ;
+      frame.len = 1 ;
+    }
+    gIndex += 1 ;
+    can.tryToSend (frame) ;
+  }
+  can.dispatchReceivedMessage () ;
+//--- Snapshot of the statistics every 5 s, counters are reset
+  if (gReportDate < millis ()) {
+    gReportDate += 5000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    ACAN2517::FilterStatistics statistics ;
+    if (can.getFilterStatistics (statistics, true)) {
+      for (uint8_t i = 0 ; i < 3 ; i++) {
+        Serial.print ("Filter ") ;
+        Serial.print (i) ;
+        Serial.print (": ") ;
+        Serial.print (statistics.mFrameCount [i]) ;
+        Serial.print (" frames, ") ;
+        Serial.print (statistics.mByteCount [i]) ;
+        Serial.println (" bytes") ;
+      }
+    }
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
@@ -0,0 +1,151 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Immediate Filter Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   IMMEDIATE CALL BACK
+//——————————————————————————————————————————————————————————————————————————————
+
+//--- Runs in the driver handler task, with the SPI transaction open: short, no driver call, no Serial
+
+static volatile uint32_t gEmergencyCount = 0 ;
+static volatile uint32_t gEmergencyLatencyMS = 0 ;
+
+static void emergencyStop (const CANMessage & inMessage) {
+  gEmergencyCount = gEmergencyCount + 1 ;
+  const uint32_t sendDate = inMessage.data32 [0] ;
+  gEmergencyLatencyMS = millis () - sendDate ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   NORMAL CALL BACK (called by dispatchReceivedMessage)
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gNormalCount = 0 ;
+
+static void normalFrame (const CANMessage & inMessage) {
+  gNormalCount += 1 ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+//--- Small driver receive buffer, so that loop leaves it full (backpressure)
+  settings.mDriverReceiveFIFOSize = 4 ;
+  settings.mDriverReceiveOverflowPolicy = ACAN2517Settings::Backpressure ;
+//--- Controller receive FIFO of the immediate filters (default value)
+  settings.mControllerImmediateReceiveFIFOSize = 4 ;
+//--- Immediate call backs run on the handler task stack (default value)
+  settings.mESP32HandlerTaskStackSize = 4096 ;
+//----------------------------------- Filters
+  ACAN2517Filters filters ;
+  filters.appendFrameFilter (kStandard, 0x000, emergencyStop) ; // Filter #0: emergency stop
+  filters.appendFrameFilter (kStandard, 0x100, normalFrame) ; // Filter #1: normal traffic
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }, filters) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- Filter #0 is immediate (begin clears all immediate flags)
+  if (!can.setImmediateFilter (0, true)) {
+    Serial.println ("setImmediateFilter error") ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+//--- Normal frames every 10 ms, an emergency frame every 3 s; the driver receive buffer is only drained
+//    every second, so normal frames wait in the controller receive FIFO, but emergency frames do not
+
+static uint32_t gNormalSendDate = 0 ;
+static uint32_t gEmergencySendDate = 3000 ;
+static uint32_t gDrainDate = 0 ;
+static uint32_t gReportedEmergencyCount = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gNormalSendDate < millis ()) {
+    gNormalSendDate += 10 ;
+    CANMessage frame ;
+    frame.id = 0x100 ;
+    can.tryToSend (frame) ;
+  }
+  if (gEmergencySendDate < millis ()) {
+    gEmergencySendDate += 3000 ;
+    CANMessage frame ;
+    frame.id = 0x000 ;
+    frame.len = 4 ;
+    frame.data32 [0] = millis () ;
+    can.tryToSend (frame) ;
+  }
+  if (gReportedEmergencyCount != gEmergencyCount) {
+    gReportedEmergencyCount = gEmergencyCount ;
+    Serial.print ("Emergency stop #") ;
+    Serial.print (gReportedEmergencyCount) ;
+    Serial.print (", latency ") ;
+    Serial.print (gEmergencyLatencyMS) ;
+    Serial.println (" ms") ;
+  }
+  if (gDrainDate < millis ()) {
+    gDrainDate += 1000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    while (can.dispatchReceivedMessage ()) {
+    }
+    Serial.print ("Normal frames: ") ;
+    Serial.println (gNormalCount) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
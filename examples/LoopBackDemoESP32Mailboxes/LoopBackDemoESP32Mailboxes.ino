@@ -0,0 +1,124 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Mailbox Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   MAILBOX
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint16_t gSpeedMailbox = ACAN2517::kNoMailbox ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+  settings.mMailboxCapacity = 4 ;
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- Latest 0x0B4 frame is written in its mailbox, not in the receive buffer
+  gSpeedMailbox = can.registerMailbox (kStandard, 0x0B4) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+//--- 0x0B4 (speed) is sent every 10 ms, 0x100 every second; the speed is read every 500 ms
+
+static uint32_t gSpeedDate = 0 ;
+static uint32_t gSendDate = 0 ;
+static uint32_t gReadDate = 0 ;
+static uint16_t gSpeed = 0 ;
+static uint32_t gLastSequence = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gSpeedDate < millis ()) {
+    gSpeedDate += 10 ;
+    gSpeed += 1 ;
+    CANMessage frame ;
+    frame.id = 0x0B4 ;
+    frame.len = 2 ;
+    frame.data16 [0] = gSpeed ;
+    can.tryToSend (frame) ;
+  }
+  if (gSendDate < millis ()) {
+    gSendDate += 1000 ;
+    CANMessage frame ;
+    frame.id = 0x100 ;
+    can.tryToSend (frame) ;
+  }
+//--- The speed burst never evicts other frames from the receive buffer
+  CANMessage frame ;
+  if (can.receive (frame)) {
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    Serial.print ("Received 0x") ;
+    Serial.println (frame.id, HEX) ;
+  }
+//--- Reading a mailbox takes no lock
+  if (gReadDate < millis ()) {
+    gReadDate += 500 ;
+    uint32_t sequence ;
+    if (can.readMailbox (gSpeedMailbox, frame, sequence) && (sequence != gLastSequence)) {
+      Serial.print ("Speed: ") ;
+      Serial.print (frame.data16 [0]) ;
+      Serial.print (", frames since last read: ") ;
+      Serial.println ((sequence - gLastSequence) / 2) ; // Sequence is 2 * update count
+      gLastSequence = sequence ;
+    }
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
@@ -0,0 +1,110 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Receive Overflow Policy Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+//--- Small driver receive buffer: when it is full, its oldest message is dropped
+  settings.mDriverReceiveFIFOSize = 8 ;
+  settings.mDriverReceiveOverflowPolicy = ACAN2517Settings::DropOldest ;
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+//--- A burst of 20 numbered frames is sent every 2 s; the receive buffer is read 1 s later
+
+static uint32_t gSendDate = 0 ;
+static uint32_t gReadDate = 1000 ;
+static uint8_t gNumber = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gSendDate < millis ()) {
+    gSendDate += 2000 ;
+    for (uint8_t i = 0 ; i < 20 ; i++) {
+      CANMessage frame ;
+      frame.id = 0x100 ;
+      frame.len = 1 ;
+      frame.data [0] = gNumber ;
+      gNumber += 1 ;
+      can.tryToSend (frame) ;
+    }
+  }
+  if (gReadDate < millis ()) {
+    gReadDate += 2000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  //--- Only the 8 latest frames of the burst remain
+    Serial.print ("Received:") ;
+    CANMessage frame ;
+    while (can.receive (frame)) {
+      Serial.print (" ") ;
+      Serial.print (frame.data [0]) ;
+    }
+    Serial.println () ;
+  //--- Counters are read without locking
+    Serial.print ("Driver drops: ") ;
+    Serial.print (can.driverReceiveDropCount ()) ;
+    Serial.print (", controller FIFO overflows: ") ;
+    Serial.println (can.controllerReceiveOverflowCount ()) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
@@ -0,0 +1,129 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Periodic Transmit Scheduler Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   PERIODIC FRAMES
+//——————————————————————————————————————————————————————————————————————————————
+
+static constexpr ACAN2517EncodedFrame kFast (kStandard, 0x100, 1, 0x00) ;
+static constexpr ACAN2517EncodedFrame kSlow (kStandard, 0x200, 1, 0x00) ;
+
+static uint16_t gFastHandle = ACAN2517::kNoPeriodicFrame ;
+static uint16_t gSlowHandle = ACAN2517::kNoPeriodicFrame ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   MISSED DEADLINE CALL BACK
+//——————————————————————————————————————————————————————————————————————————————
+
+//--- On ESP32, tick runs in the driver handler task: the call back only updates volatile data
+
+static volatile uint32_t gMissedDeadlineCount = 0 ;
+
+static void missedDeadline (const uint16_t inHandle, const uint32_t inMissedCount) {
+  gMissedDeadlineCount = gMissedDeadlineCount + inMissedCount ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+  settings.mPeriodicFrameCapacity = 4 ;
+  settings.mPeriodicSchedulerWheelSize = 64 ; // Power of 2
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- Register periodic frames (tick is called by the ESP32 handler task)
+  gFastHandle = can.registerPeriodicFrame (kFast, 100) ; // Every 100 ms
+  gSlowHandle = can.registerPeriodicFrame (kSlow, 1000, 50) ; // Every second, 50 ms phase
+  can.setMissedDeadlineCallBack (missedDeadline) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gReportDate = 0 ;
+static uint32_t gFastCount = 0 ;
+static uint32_t gSlowCount = 0 ;
+static uint8_t gSlowData = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  CANMessage frame ;
+  if (can.receive (frame)) {
+    if (frame.id == 0x100) {
+      gFastCount += 1 ;
+    }else if (frame.id == 0x200) {
+      gSlowCount += 1 ;
+    }
+  }
+  if (gReportDate < millis ()) {
+    gReportDate += 2000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    Serial.print ("0x100: ") ;
+    Serial.print (gFastCount) ;
+    Serial.print (", 0x200: ") ;
+    Serial.print (gSlowCount) ;
+    Serial.print (", missed deadlines: ") ;
+    Serial.print (gMissedDeadlineCount) ;
+    Serial.print (" / ") ;
+    Serial.println (can.periodicMissedDeadlineCount ()) ;
+  //--- Change the data of the slow frame; its cadence is unchanged
+    gSlowData += 1 ;
+    can.setPeriodicFrame (gSlowHandle, ACAN2517EncodedFrame (kStandard, 0x200, 1, gSlowData)) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
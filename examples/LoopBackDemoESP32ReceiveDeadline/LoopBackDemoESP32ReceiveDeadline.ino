@@ -0,0 +1,124 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Receive Deadline Monitor Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   RECEIVE DEADLINE CALL BACK
+//——————————————————————————————————————————————————————————————————————————————
+
+//--- On ESP32, tick runs in the driver handler task: the call back only updates volatile data
+
+static volatile bool gDeadlineExpired = false ;
+
+static void receiveDeadlineExpired (const uint16_t inIndex) {
+  gDeadlineExpired = true ;
+}
+
+static uint16_t gMonitorIndex = ACAN2517::kNoMonitoredFrame ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+  settings.mReceiveDeadlineCapacity = 4 ;
+  settings.mReceiveDeadlineWheelSize = 64 ; // Power of 2
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- Frame 0x100 should be received at least every 300 ms
+  gMonitorIndex = can.monitorReceiveDeadline (kStandard, 0x100, 300) ;
+  can.setReceiveDeadlineCallBack (receiveDeadlineExpired) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+//--- 0x100 is sent every 100 ms during 5 s, then sending is paused during 2 s
+
+static uint32_t gSendDate = 0 ;
+static uint32_t gPhaseDate = 0 ;
+static bool gSending = true ;
+static bool gWasExpired = false ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gPhaseDate < millis ()) {
+    gPhaseDate += gSending ? 5000 : 2000 ;
+    gSending = !gSending ;
+    Serial.println (gSending ? "Sending 0x100" : "Pause") ;
+  }
+  if (gSending && (gSendDate < millis ())) {
+    gSendDate = millis () + 100 ;
+    CANMessage frame ;
+    frame.id = 0x100 ;
+    can.tryToSend (frame) ;
+  }
+  CANMessage frame ;
+  if (can.receive (frame) && (frame.id == 0x100)) {
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+  if (gDeadlineExpired) {
+    gDeadlineExpired = false ;
+    Serial.print ("0x100 time out, expiration count: ") ;
+    Serial.println (can.receiveDeadlineExpirationCount ()) ;
+  }
+  const bool expired = can.receiveDeadlineExpired (gMonitorIndex) ; // Cleared by the next reception
+  if (gWasExpired && !expired) {
+    Serial.println ("0x100 received again") ;
+  }
+  gWasExpired = expired ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
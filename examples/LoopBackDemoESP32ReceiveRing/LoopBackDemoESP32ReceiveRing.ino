@@ -0,0 +1,117 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 User Receive Ring Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   USER RECEIVE RING (application owned storage)
+//——————————————————————————————————————————————————————————————————————————————
+
+static const uint32_t RING_CAPACITY = 256 ; // Holds RING_CAPACITY - 1 messages
+
+static CANMessage gRing [RING_CAPACITY] ;
+static volatile uint32_t gWriteIndex = 0 ; // Written by the driver only
+static volatile uint32_t gReadIndex = 0 ; // Written by the application only
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- Messages are decoded by the driver directly in the ring
+  if (!can.setReceiveRing (gRing, RING_CAPACITY, & gWriteIndex, & gReadIndex)) {
+    Serial.println ("setReceiveRing error") ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gSendDate = 0 ;
+static uint32_t gReportDate = 0 ;
+static uint32_t gReceivedCount = 0 ;
+static uint32_t gIdentifierSum = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gSendDate < millis ()) {
+    gSendDate += 100 ;
+    for (uint32_t i = 0 ; i < 16 ; i++) {
+      CANMessage frame ;
+      frame.id = 0x100 + i ;
+      can.tryToSend (frame) ;
+    }
+  }
+//--- Drain the ring, then tell the driver that room has been made
+  if (gReadIndex != gWriteIndex) {
+    while (gReadIndex != gWriteIndex) {
+      gIdentifierSum += gRing [gReadIndex].id ;
+      gReceivedCount += 1 ;
+      gReadIndex = (gReadIndex + 1) % RING_CAPACITY ;
+    }
+    can.notifyReceiveRingConsumed () ;
+  }
+  if (gReportDate < millis ()) {
+    gReportDate += 2000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    Serial.print ("Received: ") ;
+    Serial.print (gReceivedCount) ;
+    Serial.print (", identifier sum: ") ;
+    Serial.println (gIdentifierSum) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
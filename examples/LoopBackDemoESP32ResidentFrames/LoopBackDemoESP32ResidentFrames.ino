@@ -0,0 +1,112 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Controller Resident Frame Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   HEARTBEAT FRAME, RESIDENT IN CONTROLLER RAM (slot 0)
+//——————————————————————————————————————————————————————————————————————————————
+
+static CANMessage gHeartbeat ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+  settings.mControllerResidentTransmitFIFOCount = 1 ; // Slot 0
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- Load heartbeat frame in resident FIFO: written once via SPI
+  gHeartbeat.id = 0x700 ;
+  gHeartbeat.len = 1 ;
+  gHeartbeat.data [0] = 0 ;
+  if (!can.setResidentFrame (0, gHeartbeat)) {
+    Serial.println ("setResidentFrame error") ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gBlinkLedDate = 0 ;
+static uint32_t gReceivedFrameCount = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gBlinkLedDate < millis ()) {
+    gBlinkLedDate += 1000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  //--- Only changed data words are written, then a single byte SPI write sends the frame
+    gHeartbeat.data [0] += 1 ;
+    if (!can.updateResidentFrameData (0, gHeartbeat)) {
+      Serial.println ("Heartbeat still pending") ;
+    }else if (can.triggerResidentFrame (0)) {
+      Serial.print ("Heartbeat sent: ") ;
+      Serial.println (gHeartbeat.data [0]) ;
+    }
+  }
+  CANMessage frame ;
+  if (can.receive (frame)) {
+    gReceivedFrameCount += 1 ;
+    Serial.print ("Received 0x") ;
+    Serial.print (frame.id, HEX) ;
+    Serial.print (", data: ") ;
+    Serial.print (frame.data [0]) ;
+    Serial.print (", count: ") ;
+    Serial.println (gReceivedFrameCount) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
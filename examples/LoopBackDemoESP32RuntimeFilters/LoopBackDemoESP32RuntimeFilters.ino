@@ -0,0 +1,124 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Runtime Filter Update Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   RECEIVE FUNCTIONS
+//——————————————————————————————————————————————————————————————————————————————
+
+static void receiveFromFilter0 (const CANMessage & inMessage) {
+  Serial.print ("Filter 0: 0x") ;
+  Serial.println (inMessage.id, HEX) ;
+}
+
+static void receiveFromFilter1 (const CANMessage & inMessage) {
+  Serial.print ("Filter 1: 0x") ;
+  Serial.println (inMessage.id, HEX) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+//----------------------------------- Filters #0 and #1
+  ACAN2517Filters filters ;
+  filters.appendFrameFilter (kStandard, 0x123, receiveFromFilter0) ;
+  filters.appendFrameFilter (kStandard, 0x124, receiveFromFilter1) ;
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }, filters) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gSendDate = 0 ;
+static uint32_t gChangeDate = 5000 ;
+static uint8_t gStep = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+//--- 0x123, 0x124 and 0x125 are sent every second
+  if (gSendDate < millis ()) {
+    gSendDate += 1000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    for (uint32_t identifier = 0x123 ; identifier <= 0x125 ; identifier++) {
+      CANMessage frame ;
+      frame.id = identifier ;
+      can.tryToSend (frame) ;
+    }
+  }
+//--- Filters are changed every 5 s, without calling begin
+  if (gChangeDate < millis ()) {
+    gChangeDate += 5000 ;
+    if (gStep == 0) {
+      Serial.println ("Filter 1 now accepts 0x125") ;
+      can.replaceFrameFilter (1, kStandard, 0x125, receiveFromFilter1) ;
+    }else if (gStep == 1) {
+      Serial.println ("Filter 0 disabled") ;
+      can.disableFilter (0) ;
+    }else if (gStep == 2) {
+      Serial.println ("Filter 0 enabled") ;
+      can.enableFilter (0) ;
+    }else{
+      Serial.println ("Filter 1 now accepts 0x124") ;
+      can.replaceFrameFilter (1, kStandard, 0x124, receiveFromFilter1) ;
+    }
+    gStep = (gStep + 1) % 4 ;
+  }
+  can.dispatchReceivedMessage () ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
@@ -0,0 +1,118 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Software Dispatch Table Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   RECEIVE FUNCTIONS
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gNodeFrameCount = 0 ;
+static uint32_t g3xxFrameCount = 0 ;
+
+static void receiveNodeFrame (const CANMessage & inMessage) {
+  gNodeFrameCount += 1 ;
+}
+
+static void receive3xx (const CANMessage & inMessage) {
+  g3xxFrameCount += 1 ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+  settings.mSoftwareFrameFilterCapacity = 64 ; // Exact identifiers (hash table)
+  settings.mSoftwareMaskFilterCapacity = 2 ; // Mask / acceptance rules, tried in order
+//----------------------------------- Enter configuration: pass all hardware filter, without call back
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- 48 exact identifiers, more than the 32 hardware filters
+  for (uint32_t i = 0 ; i < 48 ; i++) {
+    can.appendSoftwareFrameFilter (kStandard, 0x200 + i, receiveNodeFrame) ;
+  }
+  can.appendSoftwareFilter (kStandard, 0x700, 0x300, receive3xx) ; // 0x300 ... 0x3FF
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gSendDate = 0 ;
+static uint32_t gReportDate = 0 ;
+static uint32_t gIndex = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+  if (gSendDate < millis ()) {
+    gSendDate += 20 ;
+  //--- 0x200 ... 0x22F, 0x300 ... 0x32F and 0x400 ... 0x42F (unwanted)
+    CANMessage frame ;
+    frame.id = 0x200 + 0x100 * (gIndex / 48) + (gIndex % 48) ;
+    gIndex = (gIndex + 1) % (3 * 48) ;
+    can.tryToSend (frame) ;
+  }
+  can.dispatchReceivedMessage () ;
+  if (gReportDate < millis ()) {
+    gReportDate += 2000 ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    Serial.print ("Node frames: ") ;
+    Serial.print (gNodeFrameCount) ;
+    Serial.print (", 0x3xx frames: ") ;
+    Serial.print (g3xxFrameCount) ;
+    Serial.print (", rejected: ") ;
+    Serial.println (can.softwareRejectedFrameCount ()) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
@@ -0,0 +1,122 @@
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Buffer Watermark Demo in loopback mode, for ESP32
+//——————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  #error "Select an ESP32 board"
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <SPI.h>
+
+//——————————————————————————————————————————————————————————————————————————————
+//  MCP2517 connections: adapt these settings to your design
+//  See the LoopBackDemoESP32 sketch for the ESP32 SPI notes.
+//  CS input of MCP2517 should be connected to a digital output port
+//  INT output of MCP2517 should be connected to a digital input port, with interrupt capability
+//——————————————————————————————————————————————————————————————————————————————
+
+static const byte MCP2517_SCK  = 26 ; // SCK input of MCP2517
+static const byte MCP2517_MOSI = 19 ; // SDI input of MCP2517
+static const byte MCP2517_MISO = 18 ; // SDO output of MCP2517
+
+static const byte MCP2517_CS  = 16 ; // CS input of MCP2517
+static const byte MCP2517_INT = 32 ; // INT output of MCP2517
+
+//——————————————————————————————————————————————————————————————————————————————
+//  ACAN2517 Driver object
+//——————————————————————————————————————————————————————————————————————————————
+
+ACAN2517 can (MCP2517_CS, SPI, MCP2517_INT) ;
+
+//——————————————————————————————————————————————————————————————————————————————
+//   WATERMARK CALL BACKS
+//——————————————————————————————————————————————————————————————————————————————
+
+//--- Called by the interrupt service routine (ESP32 handler task) or by the driver functions: they only
+//    update volatile flags, they do not call the driver
+
+static volatile bool gBatchReady = false ;
+static volatile bool gTransmitBlocked = false ;
+
+static void receiveWatermark (const bool inHigh) {
+  if (inHigh) {
+    gBatchReady = true ;
+  }
+}
+
+static void transmitWatermark (const bool inHigh) {
+  gTransmitBlocked = inHigh ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   SETUP
+//——————————————————————————————————————————————————————————————————————————————
+
+void setup () {
+//--- Switch on builtin led
+  pinMode (LED_BUILTIN, OUTPUT) ;
+  digitalWrite (LED_BUILTIN, HIGH) ;
+//--- Start serial
+  Serial.begin (115200) ;
+//--- Wait for serial (blink led at 10 Hz during waiting)
+  while (!Serial) {
+    delay (50) ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+  }
+//----------------------------------- Begin SPI
+  SPI.begin (MCP2517_SCK, MCP2517_MISO, MCP2517_MOSI) ;
+//----------------------------------- Configure ACAN2517
+  Serial.println ("Configure ACAN2517") ;
+  ACAN2517Settings settings (ACAN2517Settings::OSC_4MHz10xPLL, 125 * 1000) ; // CAN bit rate 125 kb/s
+  settings.mRequestedMode = ACAN2517Settings::InternalLoopBack ; // Select loopback mode
+//----------------------------------- Enter configuration
+  const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }) ;
+//----------------------------------- Config ok ?
+  if (errorCode != 0) {
+    Serial.print ("Configuration error 0x") ;
+    Serial.println (errorCode, HEX) ;
+  }
+//----------------------------------- Receive: notified at 16 messages; transmit: blocked at 12, unblocked at 4
+  can.setReceiveWatermarks (16, 0, receiveWatermark) ;
+  can.setTransmitWatermarks (12, 4, transmitWatermark) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————
+//   LOOP
+//——————————————————————————————————————————————————————————————————————————————
+
+static uint32_t gSendDate = 0 ;
+static uint32_t gSentCount = 0 ;
+static uint32_t gReceivedCount = 0 ;
+
+//——————————————————————————————————————————————————————————————————————————————
+
+void loop () {
+//--- The producer stops while the driver transmit buffer is above its high watermark
+  if ((gSendDate < millis ()) && !gTransmitBlocked) {
+    gSendDate += 10 ;
+    CANMessage frame ;
+    frame.id = 0x100 ;
+    if (can.tryToSend (frame)) {
+      gSentCount += 1 ;
+    }
+  }
+//--- The consumer runs only when a batch is ready, instead of polling available
+  if (gBatchReady) {
+    gBatchReady = false ;
+    digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN)) ;
+    CANMessage frame ;
+    while (can.receive (frame)) {
+      gReceivedCount += 1 ;
+    }
+    Serial.print ("Sent: ") ;
+    Serial.print (gSentCount) ;
+    Serial.print (", received: ") ;
+    Serial.println (gReceivedCount) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————
@@ -6,6 +6,7 @@
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 #define OPTIMIZED_SPI
 #include <ACAN2517.h>
+#include <ACAN2517MemoryBarrier.h>
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 // Note about ESP32
@@ -22,7 +23,9 @@
 //   - this activates the myESP32Task task that performs "isr_core" that is done by interrupt service routine
 //     in "usual" Arduino;
 //   - as this task runs in parallel with setup / loop routines, SPI access is natively protected by the
-//     beginTransaction / endTransaction pair, that manages a mutex.
+//     beginTransaction / endTransaction pair, that manages a mutex;
+//   - if a periodic scheduler or a receive deadline monitor is configured, the task also wakes up every tick
+//     and calls "tick".
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
@@ -30,11 +33,14 @@
   static void myESP32Task (void * pData) {
     ACAN2517 * canDriver = (ACAN2517 *) pData ;
     while (1) {
-      xSemaphoreTake (canDriver->mISRSemaphore, portMAX_DELAY) ;
-      bool loop = true ;
-      while (loop) {
-        loop = canDriver->isr_core () ;
-	    }
+      const TickType_t timeOut = canDriver->needsTick () ? 1 : portMAX_DELAY ;
+      if (xSemaphoreTake (canDriver->mISRSemaphore, timeOut) == pdTRUE) {
+        bool loop = true ;
+        while (loop) {
+          loop = canDriver->isr_core () ;
+        }
+      }
+      canDriver->tick (millis ()) ;
     }
   }
 #endif
@@ -64,6 +70,8 @@ static const uint16_t C1TXQUA_REGISTER    = 0x058 ;
 //······················································································································
 
 static const uint16_t C1INT_REGISTER = 0x01C ;
+static const uint16_t C1RXIF_REGISTER = 0x020 ;
+static const uint16_t C1RXOVIF_REGISTER = 0x028 ;
 
 //······················································································································
 //   FIFO REGISTERS
@@ -123,6 +131,17 @@ static const uint16_t IOCON_REGISTER = 0xE04 ;
 
 static const uint8_t receiveFIFOIndex = 1 ;
 
+//--- Receive FIFO C1FIFOCON byte 0 (DS20005688B, page 52): RXOVIE is always set, TFNRFNIE is cleared while
+//    driver receive buffer is full (backpressure)
+static const uint8_t receiveFIFOInterruptsEnabled = (1 << 3) | (1 << 0) ; // RXOVIE, TFNRFNIE
+static const uint8_t receiveFIFONotEmptyInterruptDisabled = 1 << 3 ; // RXOVIE
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    FIRST RESIDENT TRANSMIT FIFO INDEX
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+static const uint8_t residentTransmitFIFOIndex = 3 ;
+
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
 ACAN2517::ACAN2517 (const uint8_t inCS, // CS input of MCP2517FD
@@ -138,6 +157,8 @@ mDriverReceiveBuffer (),
 mDriverTransmitBuffer ()
 #ifdef ARDUINO_ARCH_ESP32
   , mISRSemaphore (xSemaphoreCreateCounting (10, 0))
+  , mReceiveSemaphore (xSemaphoreCreateBinary ())
+  , mTransmitSemaphore (xSemaphoreCreateBinary ())
 #endif
 {
 }
@@ -147,8 +168,7 @@ mDriverTransmitBuffer ()
 uint32_t ACAN2517::begin (const ACAN2517Settings & inSettings,
                           void (* inInterruptServiceRoutine) (void)) {
 //--- Add pass-all filter
-  ACAN2517Filters filters ;
-  filters.appendPassAllFilter (NULL) ;
+  static const ACAN2517ConstantFilter filters [1] = { ACAN2517ConstantFilter::passAllFilter (NULL) } ;
 //---
   return begin (inSettings, inInterruptServiceRoutine, filters) ;
 }
@@ -158,6 +178,25 @@ uint32_t ACAN2517::begin (const ACAN2517Settings & inSettings,
 uint32_t ACAN2517::begin (const ACAN2517Settings & inSettings,
                           void (* inInterruptServiceRoutine) (void),
                           const ACAN2517Filters & inFilters) {
+  return beginWithFilters (inSettings, inInterruptServiceRoutine, & inFilters, NULL, 0) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::begin (const ACAN2517Settings & inSettings,
+                          void (* inInterruptServiceRoutine) (void),
+                          const ACAN2517ConstantFilter inFilters [],
+                          const uint8_t inFilterCount) {
+  return beginWithFilters (inSettings, inInterruptServiceRoutine, NULL, inFilters, inFilterCount) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::beginWithFilters (const ACAN2517Settings & inSettings,
+                                     void (* inInterruptServiceRoutine) (void),
+                                     const ACAN2517Filters * inFilters,
+                                     const ACAN2517ConstantFilter inConstantFilters [],
+                                     const uint8_t inConstantFilterCount) {
   uint32_t errorCode = 0 ; // Means no error
 //----------------------------------- If ok, check if settings are correct
   if (!inSettings.mBitRateClosedToDesiredRate) {
@@ -203,17 +242,52 @@ uint32_t ACAN2517::begin (const ACAN2517Settings & inSettings,
   if (inSettings.mControllerTransmitFIFOPriority > 31) {
     errorCode |= kControllerTransmitFIFOPriorityGreaterThan31 ;
   }
+//----------------------------------- Check resident transmit FIFO count is <= 29 (FIFO #3 ... #31)
+  if (inSettings.mControllerResidentTransmitFIFOCount > 29) {
+    errorCode |= kControllerResidentTransmitFIFOCountGreaterThan29 ;
+  }
+//----------------------------------- Check immediate receive FIFO size is <= 32, and a FIFO is free for it
+  if (inSettings.mControllerImmediateReceiveFIFOSize > 32) {
+    errorCode |= kControllerImmediateReceiveFIFOSizeGreaterThan32 ;
+  }
+  if ((inSettings.mControllerImmediateReceiveFIFOSize > 0) && (inSettings.mControllerResidentTransmitFIFOCount >= 29)) {
+    errorCode |= kNoControllerFIFOForImmediateFilters ;
+  }
+//----------------------------------- Check resident transmit FIFO priority is <= 31
+  if (inSettings.mControllerResidentTransmitFIFOPriority > 31) {
+    errorCode |= kControllerResidentTransmitFIFOPriorityGreaterThan31 ;
+  }
 //----------------------------------- Check MCP2517FD controller RAM usage is <= 2048 bytes
   if (inSettings.ramUsage () > 2048) {
     errorCode |= kControllerRamUsageGreaterThan2048 ;
   }
 //----------------------------------- Check Filter definition
-  if (inFilters.filterCount () > 32) {
+  uint8_t filterCount = inConstantFilterCount ;
+  bool filtersOk = true ;
+  if (inFilters != NULL) {
+    filterCount = inFilters->filterCount () ;
+    filtersOk = inFilters->filterStatus () == ACAN2517Filters::kFiltersOk ;
+  }
+  for (uint8_t i = 0 ; i < inConstantFilterCount ; i++) {
+    filtersOk &= inConstantFilters [i].mFilterStatus == ACAN2517Filters::kFiltersOk ;
+  }
+  if (filterCount > 32) {
     errorCode |= kMoreThan32Filters ;
   }
-  if (inFilters.filterStatus () != ACAN2517Filters::kFiltersOk) {
+  if (!filtersOk) {
     errorCode |= kFilterDefinitionError ;
   }
+//----------------------------------- Check periodic scheduler wheel size is a power of 2
+  const uint16_t wheelSize = inSettings.mPeriodicSchedulerWheelSize ;
+  if ((inSettings.mPeriodicFrameCapacity > 0) && ((wheelSize == 0) || ((wheelSize & (wheelSize - 1)) != 0))) {
+    errorCode |= kPeriodicSchedulerWheelSizeNotPowerOf2 ;
+  }
+//----------------------------------- Check receive deadline wheel size is a power of 2
+  const uint16_t deadlineWheelSize = inSettings.mReceiveDeadlineWheelSize ;
+  if ((inSettings.mReceiveDeadlineCapacity > 0)
+   && ((deadlineWheelSize == 0) || ((deadlineWheelSize & (deadlineWheelSize - 1)) != 0))) {
+    errorCode |= kReceiveDeadlineWheelSizeNotPowerOf2 ;
+  }
 //----------------------------------- CS and INT pins
   if (errorCode == 0) {
     if (mINT != 255) { // 255 means interrupt is not used
@@ -306,7 +380,102 @@ uint32_t ACAN2517::begin (const ACAN2517Settings & inSettings,
   if (errorCode == 0) {
   //----------------------------------- Configure transmit and receive buffers
     mDriverTransmitBuffer.initWithSize (inSettings.mDriverTransmitFIFOSize) ;
-    mDriverReceiveBuffer.initWithSize (inSettings.mDriverReceiveFIFOSize) ;
+    mReceiveOverflowPolicy = inSettings.mDriverReceiveOverflowPolicy ;
+    mDriverReceiveDropCount = 0 ;
+    mDroppedOldestCount = 0 ;
+    mControllerReceiveOverflowCount = 0 ;
+    delete mRawReceiveBuffer ;
+    mRawReceiveBuffer = NULL ;
+    if (inSettings.mDeferredReceiveDecoding) {
+      mRawReceiveBuffer = new ACAN2517RawBuffer () ;
+      mRawReceiveBuffer->initWithSize (inSettings.mDriverReceiveFIFOSize) ;
+      mDriverReceiveBuffer.initWithSize (0) ;
+    }else{
+      mDriverReceiveBuffer.initWithSize (inSettings.mDriverReceiveFIFOSize) ;
+    }
+  //----------------------------------- Configure periodic scheduler
+    delete mPeriodicScheduler ;
+    mPeriodicScheduler = NULL ;
+    if (inSettings.mPeriodicFrameCapacity > 0) {
+      mPeriodicScheduler = new ACAN2517PeriodicScheduler () ;
+      if (!mPeriodicScheduler->initWithSize (inSettings.mPeriodicFrameCapacity, wheelSize, millis ())) {
+        delete mPeriodicScheduler ;
+        mPeriodicScheduler = NULL ;
+        errorCode |= kPeriodicSchedulerInitializationError ;
+      }
+    }
+  //----------------------------------- Configure software dispatch table (adaptive placement is stopped)
+    delete mAdaptiveFilterCompiler ;
+    mAdaptiveFilterCompiler = NULL ;
+    delete [] mAdaptiveHotIndexes ;
+    mAdaptiveHotIndexes = NULL ;
+    delete [] mAdaptiveFilters ;
+    mAdaptiveFilters = NULL ;
+    mAdaptiveFirstFilterIndex = 32 ;
+    mAdaptivePeriodMS = 0 ;
+    delete mSoftwareDispatchTable ;
+    mSoftwareDispatchTable = NULL ;
+    if ((inSettings.mSoftwareFrameFilterCapacity > 0) || (inSettings.mSoftwareMaskFilterCapacity > 0)) {
+      mSoftwareDispatchTable = new ACAN2517SoftwareDispatchTable () ;
+      mSoftwareDispatchTable->initWithSize (inSettings.mSoftwareFrameFilterCapacity,
+                                            inSettings.mSoftwareMaskFilterCapacity) ;
+    }
+  //----------------------------------- Configure receive deadline monitor
+    delete mReceiveDeadlineMonitor ;
+    mReceiveDeadlineMonitor = NULL ;
+    if (inSettings.mReceiveDeadlineCapacity > 0) {
+      mReceiveDeadlineMonitor = new ACAN2517ReceiveDeadlineMonitor () ;
+      if (!mReceiveDeadlineMonitor->initWithSize (inSettings.mReceiveDeadlineCapacity, deadlineWheelSize, millis ())) {
+        delete mReceiveDeadlineMonitor ;
+        mReceiveDeadlineMonitor = NULL ;
+        errorCode |= kReceiveDeadlineInitializationError ;
+      }
+    }
+  //----------------------------------- Configure filter statistics
+    delete mFilterStatistics ;
+    mFilterStatistics = NULL ;
+    if (inSettings.mFilterStatistics) {
+      mFilterStatistics = new FilterStatistics () ; // Value initialized: counters are zero
+    }
+  //----------------------------------- Configure deny list
+    delete mDenyList ;
+    mDenyList = NULL ;
+    mDeniedFrameCount = 0 ;
+    if (inSettings.mStandardDenyList || (inSettings.mExtendedDenyListCapacity > 0)) {
+      mDenyList = new ACAN2517DenyList () ;
+      mDenyList->initWithSize (inSettings.mStandardDenyList, inSettings.mExtendedDenyListCapacity) ;
+    }
+  //----------------------------------- Configure content filter
+    delete mContentFilter ;
+    mContentFilter = NULL ;
+    mContentRejectedFrameCount = 0 ;
+    if (inSettings.mContentFilterCapacity > 0) {
+      mContentFilter = new ACAN2517ContentFilter () ;
+      mContentFilter->initWithSize (inSettings.mContentFilterCapacity) ;
+    }
+  //----------------------------------- Configure change only table
+    delete mChangeOnlyTable ;
+    mChangeOnlyTable = NULL ;
+    mUnchangedFrameCount = 0 ;
+    if (inSettings.mChangeOnlyCapacity > 0) {
+      mChangeOnlyTable = new ACAN2517ChangeOnlyTable () ;
+      mChangeOnlyTable->initWithSize (inSettings.mChangeOnlyCapacity) ;
+    }
+  //----------------------------------- Configure decimation table
+    delete mDecimationTable ;
+    mDecimationTable = NULL ;
+    mDecimatedFrameCount = 0 ;
+    if (inSettings.mDecimationCapacity > 0) {
+      mDecimationTable = new ACAN2517DecimationTable () ;
+      mDecimationTable->initWithSize (inSettings.mDecimationCapacity) ;
+    }
+  //----------------------------------- Configure mailboxes
+    delete mMailboxTable ;
+    mMailboxTable = NULL ;
+    if (inSettings.mMailboxCapacity > 0) {
+      mMailboxTable = new ACAN2517MailboxTable () ;
+      mMailboxTable->initWithSize (inSettings.mMailboxCapacity) ;
+    }
   //----------------------------------- Reset RAM
     for (uint16_t address = 0x400 ; address < 0xC00 ; address += 4) {
       writeRegister (address, 0) ;
@@ -341,7 +510,7 @@ uint32_t ACAN2517::begin (const ACAN2517Settings & inSettings,
   //----------------------------------- Configure RX FIFO (C1FIFOCON, DS20005688B, page 52)
     d = inSettings.mControllerReceiveFIFOSize - 1 ; // Set receive FIFO size
     writeByteRegister (C1FIFOCON_REGISTER (1) + 3, d) ;
-    d = 1 ; // Interrupt Enabled for FIFO not Empty (TFNRFNIE)
+    d = receiveFIFOInterruptsEnabled ; // Interrupt Enabled for FIFO not Empty (TFNRFNIE), and overflow (RXOVIE)
     writeByteRegister (C1FIFOCON_REGISTER (1), d) ;
   //----------------------------------- Configure TX FIFO (C1FIFOCON, DS20005688B, page 52)
     d = inSettings.mControllerTransmitFIFORetransmissionAttempts ;
@@ -350,27 +519,82 @@ uint32_t ACAN2517::begin (const ACAN2517Settings & inSettings,
     writeByteRegister (C1FIFOCON_REGISTER (2) + 2, d) ;
     d = inSettings.mControllerTransmitFIFOSize - 1 ; // Set transmit FIFO size
     writeByteRegister (C1FIFOCON_REGISTER (2) + 3, d) ;
+    mControllerTransmitFIFOSize = inSettings.mControllerTransmitFIFOSize ; // FIFOs are reset in configuration mode
+    mTransmitFIFOSequence = 0 ;
+    mTransmitFIFOTailIndex = 0 ;
     d = 1 << 7 ; // FIFO 2 is a Tx FIFO
     writeByteRegister (C1FIFOCON_REGISTER (2), d) ;
+  //----------------------------------- Configure resident transmit FIFOs (C1FIFOCON, DS20005688B, page 52)
+    delete [] mResidentFrameArray ;
+    mResidentFrameCount = inSettings.mControllerResidentTransmitFIFOCount ;
+    mResidentFrameArray = (mResidentFrameCount == 0) ? NULL : new ResidentFrame [mResidentFrameCount] ;
+    for (uint8_t slot = 0 ; slot < mResidentFrameCount ; slot++) {
+      const uint16_t fifo = residentTransmitFIFOIndex + slot ;
+      d = inSettings.mControllerResidentTransmitFIFORetransmissionAttempts ;
+      d <<= 5 ;
+      d |= inSettings.mControllerResidentTransmitFIFOPriority ;
+      writeByteRegister (C1FIFOCON_REGISTER (fifo) + 2, d) ;
+      writeByteRegister (C1FIFOCON_REGISTER (fifo) + 3, 0) ; // FIFO size: 1 message
+      d = 1 << 7 ; // Tx FIFO, no interrupt
+      writeByteRegister (C1FIFOCON_REGISTER (fifo), d) ;
+    }
+  //----------------------------------- Configure immediate receive FIFO (C1FIFOCON, DS20005688B, page 52)
+    mImmediateReceiveFIFOIndex = receiveFIFOIndex ;
+    if (inSettings.mControllerImmediateReceiveFIFOSize > 0) {
+      mImmediateReceiveFIFOIndex = (uint8_t) (residentTransmitFIFOIndex + mResidentFrameCount) ;
+      d = inSettings.mControllerImmediateReceiveFIFOSize - 1 ; // Set FIFO size
+      writeByteRegister (C1FIFOCON_REGISTER (mImmediateReceiveFIFOIndex) + 3, d) ;
+      d = receiveFIFOInterruptsEnabled ; // Rx FIFO, never disabled by backpressure
+      writeByteRegister (C1FIFOCON_REGISTER (mImmediateReceiveFIFOIndex), d) ;
+    }
   //----------------------------------- Configure receive filters
-    uint8_t filterIndex = 0 ;
-    ACAN2517Filters::Filter * filter = inFilters.mFirstFilter ;
-    mCallBackFunctionArray = new ACANCallBackRoutine [inFilters.filterCount ()] ;
-    while (NULL != filter) {
-      mCallBackFunctionArray [filterIndex] = filter->mCallBackRoutine ;
-      writeRegister (C1MASK_REGISTER (filterIndex), filter->mFilterMask) ; // DS20005688B, page 61
-      writeRegister (C1FLTOBJ_REGISTER (filterIndex), filter->mAcceptanceFilter) ; // DS20005688B, page 60
+    delete [] mCallBackFunctionArray ;
+    mCallBackFunctionArray = NULL ;
+    enterReceiveLock () ; // Call backs of immediate filters are called by receiveInterrupt
+      mImmediateFilters = 0 ;
+      for (uint8_t i = 0 ; i < 32 ; i++) {
+        mCallBackWithContextArray [i].mCallBackRoutine = NULL ;
+        mCallBackWithContextArray [i].mContext = NULL ;
+      }
+    leaveReceiveLock () ;
+    mConfiguredFilters = 0 ;
+    mConstantFilterTable = inConstantFilters ;
+    mConstantFilterCount = inConstantFilterCount ;
+    if (inFilters != NULL) {
+      mCallBackFunctionArray = new ACANCallBackRoutine [32] ; // Room for replaceFilter
+      for (uint8_t i = 0 ; i < 32 ; i++) {
+        mCallBackFunctionArray [i] = NULL ;
+      }
+      uint8_t filterIndex = 0 ;
+      ACAN2517Filters::Filter * filter = inFilters->mFirstFilter ;
+      while (NULL != filter) {
+        mCallBackFunctionArray [filterIndex] = filter->mCallBackRoutine ;
+        writeRegister (C1MASK_REGISTER (filterIndex), filter->mFilterMask) ; // DS20005688B, page 61
+        writeRegister (C1FLTOBJ_REGISTER (filterIndex), filter->mAcceptanceFilter) ; // DS20005688B, page 60
+        d = 1 << 7 ; // Filter is enabled
+        d |= 1 ; // Message matching filter is stored in FIFO1
+        writeByteRegister (C1FLTCON_REGISTER (filterIndex), d) ; // DS20005688B, page 58
+        mConfiguredFilters |= ((uint32_t) 1) << filterIndex ;
+        filter = filter->mNextFilter ;
+        filterIndex += 1 ;
+      }
+    }
+  //--- Constant filters: call back routines are read from the table by dispatchReceivedMessage
+    for (uint8_t filterIndex = 0 ; filterIndex < inConstantFilterCount ; filterIndex++) {
+      const ACAN2517ConstantFilter & filter = inConstantFilters [filterIndex] ;
+      writeRegister (C1MASK_REGISTER (filterIndex), filter.mFilterMask) ; // DS20005688B, page 61
+      writeRegister (C1FLTOBJ_REGISTER (filterIndex), filter.mAcceptanceFilter) ; // DS20005688B, page 60
       d = 1 << 7 ; // Filter is enabled
       d |= 1 ; // Message matching filter is stored in FIFO1
       writeByteRegister (C1FLTCON_REGISTER (filterIndex), d) ; // DS20005688B, page 58
-      filter = filter->mNextFilter ;
-      filterIndex += 1 ;
+      mConfiguredFilters |= ((uint32_t) 1) << filterIndex ;
     }
   //----------------------------------- Activate interrupts (C1INT, DS20005688B page 34)
     d  = (1 << 1) ; // Receive FIFO Interrupt Enable
     d |= (1 << 0) ; // Transmit FIFO Interrupt Enable
     writeByteRegister (C1INT_REGISTER + 2, d) ;
-    writeByteRegister (C1INT_REGISTER + 3, 0) ;
+    d = 1 << 3 ; // Receive FIFO Overflow Interrupt Enable (RXOVIE)
+    writeByteRegister (C1INT_REGISTER + 3, d) ;
   //----------------------------------- Program nominal data rate (C1NBTCFG register)
   //  bits 31-24: BRP - 1
   //  bits 23-16: TSEG1 - 1
@@ -402,7 +626,7 @@ uint32_t ACAN2517::begin (const ACAN2517Settings & inSettings,
       }
     }
     #ifdef ARDUINO_ARCH_ESP32
-      xTaskCreate (myESP32Task, "ACAN2517Handler", 1024, this, 256, NULL) ;
+      xTaskCreate (myESP32Task, "ACAN2517Handler", inSettings.mESP32HandlerTaskStackSize, this, 256, NULL) ;
     #endif
     if (mINT != 255) { // 255 means interrupt is not used
       #ifdef ARDUINO_ARCH_ESP32
@@ -422,21 +646,97 @@ uint32_t ACAN2517::begin (const ACAN2517Settings & inSettings,
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
 bool ACAN2517::tryToSend (const CANMessage & inMessage) {
-//--- Workaround: the Teensy 3.5 / 3.6 "SPI.usingInterrupt" bug (https://github.com/PaulStoffregen/SPI/issues/35)
-  #if (defined (__MK64FX512__) || defined (__MK66FX1M0__))
-    noInterrupts () ;
-  #endif
-    mSPI.beginTransaction (mSPISettings) ;
-      bool result = false ;
-      if (inMessage.idx == 0) {
-        result = enterInTransmitBuffer (inMessage) ;
-      }else if (inMessage.idx == 255) {
-        result = sendViaTXQ (inMessage) ;
-      }
-    mSPI.endTransaction () ;
-  #if (defined (__MK64FX512__) || defined (__MK66FX1M0__))
-    interrupts () ;
+  enterTransmitLock () ;
+    bool result = false ;
+    if (inMessage.idx == 0) {
+      result = enterInTransmitBuffer (inMessage) ;
+    }else if (inMessage.idx == 255) {
+      result = sendViaTXQ (inMessage) ;
+    }
+  leaveTransmitLock () ;
+  return result ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::tryToSend (const ACAN2517EncodedFrame & inFrame) {
+  enterTransmitLock () ;
+    const bool result = enterInTransmitBuffer (inFrame) ;
+  leaveTransmitLock () ;
+  return result ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::send (const CANMessage & inMessage, const uint32_t inTimeOutMS) {
+  bool sent = tryToSend (inMessage) ;
+//--- Only idx 0 (transmit FIFO) and 255 (TXQ, if enabled) can be sent: otherwise, do not wait
+  const bool canBeSent = (inMessage.idx == 0) || ((inMessage.idx == 255) && mUsesTXQ) ;
+  #ifdef ARDUINO_ARCH_ESP32
+    const TickType_t start = xTaskGetTickCount () ;
+    const TickType_t timeOut = pdMS_TO_TICKS (inTimeOutMS) ;
+    TickType_t elapsed = 0 ;
+    while (!sent && canBeSent && (elapsed < timeOut)) {
+    //--- TXQ has no interrupt: poll it every tick
+      const TickType_t wait = (inMessage.idx == 0) ? (timeOut - elapsed) : 1 ;
+      xSemaphoreTake (mTransmitSemaphore, wait) ; // A stale give only causes an extra loop
+      sent = tryToSend (inMessage) ;
+      elapsed = xTaskGetTickCount () - start ;
+    }
+  #else
+    const uint32_t start = millis () ;
+    while (!sent && canBeSent && ((millis () - start) < inTimeOutMS)) {
+      sent = tryToSend (inMessage) ;
+    }
   #endif
+  return sent ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::transmitIsComplete (void) {
+  enterTransmitLock () ;
+  //--- TFERFFIF: transmit FIFO is empty; TXQEIF: TXQ is empty (DS20005688B, pages 50 and 54)
+    bool complete = (mDriverTransmitBuffer.count () == 0)
+      && ((readByteRegisterSPI (C1FIFOSTA_REGISTER (2)) & (1 << 2)) != 0) ;
+    if (complete && mUsesTXQ) {
+      complete = (readByteRegisterSPI (C1TXQSTA_REGISTER) & (1 << 2)) != 0 ;
+    }
+  leaveTransmitLock () ;
+  return complete ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::tryToSend (const CANMessage & inMessage, uint32_t & outSequence) {
+  enterTransmitLock () ;
+    const bool result = (inMessage.idx == 0) && enterInTransmitBuffer (inMessage) ;
+  //--- Messages of the driver transmit buffer are written in the controller transmit FIFO in order
+    if (result) {
+      outSequence = mTransmitFIFOSequence + mDriverTransmitBuffer.count () ;
+    }
+  leaveTransmitLock () ;
+  return result ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::transmittedSequence (bool & outAborted) {
+  enterTransmitLock () ;
+  //--- TXATIF: bit 4, TFERFFIF (empty): bit 2, FIFOCI (next message to transmit): bits 12-8 (DS20005688B, page 54)
+    const uint32_t status = readRegisterSPI (C1FIFOSTA_REGISTER (2)) ;
+    outAborted = (status & (1 << 4)) != 0 ;
+    if (outAborted) {
+      writeByteRegisterSPI (C1FIFOSTA_REGISTER (2), 0) ; // Clear TXATIF, other bits are read only
+    }
+    const uint8_t headIndex = (uint8_t) ((status >> 8) & 0x1F) ;
+    uint8_t pendingCount = (uint8_t) ((mTransmitFIFOTailIndex + mControllerTransmitFIFOSize - headIndex)
+                                      % mControllerTransmitFIFOSize) ;
+    if ((pendingCount == 0) && ((status & (1 << 2)) == 0)) { // Head is tail, and FIFO is not empty: it is full
+      pendingCount = mControllerTransmitFIFOSize ;
+    }
+    const uint32_t result = mTransmitFIFOSequence - pendingCount ;
+  leaveTransmitLock () ;
   return result ;
 }
 
@@ -446,23 +746,45 @@ bool ACAN2517::enterInTransmitBuffer (const CANMessage & inMessage) {
   bool result ;
   if (mControllerTxFIFOFull) {
     result = mDriverTransmitBuffer.append (inMessage) ;
+    mTransmitWatermark.update (mDriverTransmitBuffer.count ()) ;
   }else{
     result = true ;
     appendInControllerTxFIFO (inMessage) ;
-  //--- If controller FIFO is full, enable "FIFO not full" interrupt
-    const uint8_t status = readByteRegisterSPI (C1FIFOSTA_REGISTER (2)) ;
-    if ((status & 1) == 0) { // FIFO is full
-      uint8_t d = 1 << 7 ;  // FIFO is a transmit FIFO
-      d |= 1 ; // Enable "FIFO not full" interrupt
-      writeByteRegisterSPI (C1FIFOCON_REGISTER (2), d) ;
-      mControllerTxFIFOFull = true ;
-    }
+    checkControllerTxFIFOFull () ;
+  }
+  return result ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::enterInTransmitBuffer (const ACAN2517EncodedFrame & inFrame) {
+  bool result ;
+  if (mControllerTxFIFOFull) { // Frame should wait in driver transmit buffer: decode it
+    result = mDriverTransmitBuffer.append (inFrame.message ()) ;
+    mTransmitWatermark.update (mDriverTransmitBuffer.count ()) ;
+  }else{
+    result = true ;
+    appendInControllerTxFIFO (inFrame) ;
+    checkControllerTxFIFOFull () ;
   }
   return result ;
 }
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
+void ACAN2517::checkControllerTxFIFOFull (void) {
+//--- If controller FIFO is full, enable "FIFO not full" interrupt
+  const uint8_t status = readByteRegisterSPI (C1FIFOSTA_REGISTER (2)) ;
+  if ((status & 1) == 0) { // FIFO is full
+    uint8_t d = 1 << 7 ;  // FIFO is a transmit FIFO
+    d |= 1 ; // Enable "FIFO not full" interrupt
+    writeByteRegisterSPI (C1FIFOCON_REGISTER (2), d) ;
+    mControllerTxFIFOFull = true ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
 void ACAN2517::appendInControllerTxFIFO (const CANMessage & inMessage) {
   const uint16_t ramAddress = (uint16_t) (0x400 + readRegisterSPI (C1FIFOUA_REGISTER (2))) ;
     //--- identifier: if an extended frame is sent, identifier bits sould be reordered (see DS20005678B, page 27)
@@ -519,6 +841,48 @@ void ACAN2517::appendInControllerTxFIFO (const CANMessage & inMessage) {
   //--- Increment FIFO, send message (see DS20005688B, page 48)
   const uint8_t d = (1 << 0) | (1 << 1) ; // Set UINC bit, TXREQ bit
   writeByteRegisterSPI (C1FIFOCON_REGISTER (2) + 1, d);
+  advanceTransmitFIFOSequence () ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517::appendInControllerTxFIFO (const ACAN2517EncodedFrame & inFrame) {
+  const uint16_t ramAddress = (uint16_t) (0x400 + readRegisterSPI (C1FIFOUA_REGISTER (2))) ;
+  writeEncodedFrameSPI (ramAddress, inFrame) ;
+//--- Increment FIFO, send message (see DS20005688B, page 48)
+  const uint8_t d = (1 << 0) | (1 << 1) ; // Set UINC bit, TXREQ bit
+  writeByteRegisterSPI (C1FIFOCON_REGISTER (2) + 1, d);
+  advanceTransmitFIFOSequence () ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517::advanceTransmitFIFOSequence (void) {
+  mTransmitFIFOSequence += 1 ;
+  mTransmitFIFOTailIndex += 1 ;
+  if (mTransmitFIFOTailIndex == mControllerTransmitFIFOSize) {
+    mTransmitFIFOTailIndex = 0 ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517::writeEncodedFrameSPI (const uint16_t inRamAddress, const ACAN2517EncodedFrame & inFrame) {
+  assertCS () ;
+  #ifndef OPTIMIZED_SPI
+    writeCommandSPI (inRamAddress) ;
+    for (uint8_t i = 0 ; i < 16 ; i++) {
+      mSPI.transfer (inFrame.object () [i]) ;
+    }
+  #else
+    unsigned char buff [18] ;
+    const uint16_t writeCommand = (inRamAddress & 0x0FFF) | (0b0010 << 12) ;
+    buff[0] = writeCommand >> 8;
+    buff[1] = writeCommand & 0xFF;
+    memcpy (buff + 2, inFrame.object (), 16) ; // Already in MCP2517FD RAM layout
+    mSPI.transfer(buff,18);
+  #endif
+  deassertCS () ;
 }
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
@@ -588,217 +952,1371 @@ bool ACAN2517::sendViaTXQ (const CANMessage & inMessage) {
 }
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-//    RECEIVE FRAME
+//    CONTROLLER RESIDENT FRAMES
+//    Each resident frame has its own single message transmit FIFO: when the frame has been sent, the FIFO is
+//    empty again, but the message object remains in controller RAM. Setting UINC and TXREQ reloads the
+//    FIFO with this very object (DS20005688B, page 52).
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
-bool ACAN2517::available (void) {
-  #ifdef ARDUINO_ARCH_ESP32
-    mSPI.beginTransaction (mSPISettings) ; // For ensuring mutual exclusion access
-  #else
-    noInterrupts () ;
-  #endif
-    const bool hasReceivedMessage = mDriverReceiveBuffer.count () > 0 ;
-  #ifdef ARDUINO_ARCH_ESP32
-    mSPI.endTransaction () ;
-  #else
-    interrupts () ;
-  #endif
-  return hasReceivedMessage ;
+bool ACAN2517::residentFrameIsPending (const uint8_t inSlot) {
+  const uint8_t con = readByteRegisterSPI (C1FIFOCON_REGISTER (residentTransmitFIFOIndex + inSlot) + 1) ;
+  return (con & (1 << 1)) != 0 ; // TXREQ bit is cleared when message has been sent
 }
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
-bool ACAN2517::receive (CANMessage & outMessage) {
-  #ifdef ARDUINO_ARCH_ESP32
-    mSPI.beginTransaction (mSPISettings) ; // For ensuring mutual exclusion access
-  #else
-    noInterrupts () ;
-  #endif
-    const bool hasReceivedMessage = mDriverReceiveBuffer.remove (outMessage) ;
-    if (hasReceivedMessage) { // Receive FIFO is not full, enable "FIFO  not empty" interrupt
-      writeByteRegisterSPI (C1FIFOCON_REGISTER (receiveFIFOIndex), 1) ;
-    }
-  #ifdef ARDUINO_ARCH_ESP32
-    mSPI.endTransaction () ;
-  #else
-    interrupts () ;
-  #endif
-//---
-  return hasReceivedMessage ;
+bool ACAN2517::setResidentFrame (const uint8_t inSlot, const CANMessage & inMessage) {
+  return setResidentFrame (inSlot, ACAN2517EncodedFrame (inMessage)) ;
 }
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
-bool ACAN2517::dispatchReceivedMessage (const tFilterMatchCallBack inFilterMatchCallBack) {
-  CANMessage receivedMessage ;
-  const bool hasReceived = receive (receivedMessage) ;
-  if (hasReceived) {
-    const uint32_t filterIndex = receivedMessage.idx ;
-    if (NULL != inFilterMatchCallBack) {
-      inFilterMatchCallBack (filterIndex) ;
-    }
-    ACANCallBackRoutine callBackFunction = (mCallBackFunctionArray == NULL)
-      ? NULL
-      : mCallBackFunctionArray [filterIndex]
-    ;
-    if (NULL != callBackFunction) {
-      callBackFunction (receivedMessage) ;
-    }
+bool ACAN2517::setResidentFrame (const uint8_t inSlot, const ACAN2517EncodedFrame & inFrame) {
+  bool ok = inSlot < mResidentFrameCount ;
+  if (ok) {
+    enterTransmitLock () ;
+      ok = !residentFrameIsPending (inSlot) ;
+      if (ok) {
+        const uint16_t fifo = residentTransmitFIFOIndex + inSlot ;
+        const uint16_t ramAddress = (uint16_t) (0x400 + readRegisterSPI (C1FIFOUA_REGISTER (fifo))) ;
+      //--- Write message object, without setting UINC: nothing is sent
+        writeEncodedFrameSPI (ramAddress, inFrame) ;
+        ResidentFrame & frame = mResidentFrameArray [inSlot] ;
+        frame.mRamAddress = ramAddress ;
+        for (uint8_t i = 0 ; i < 2 ; i++) {
+          const uint8_t * p = inFrame.object () + 8 + 4 * i ;
+          frame.mData32 [i] = p [0] | ((uint32_t) p [1] << 8) | ((uint32_t) p [2] << 16) | ((uint32_t) p [3] << 24) ;
+        }
+      }
+    leaveTransmitLock () ;
   }
-  return hasReceived ;
+  return ok ;
 }
 
-//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-//    POLLING (ESP32)
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
-#ifdef ARDUINO_ARCH_ESP32
-  void ACAN2517::poll (void) {
-    xSemaphoreGive (mISRSemaphore) ;
+bool ACAN2517::triggerResidentFrame (const uint8_t inSlot) {
+  bool ok = (inSlot < mResidentFrameCount) && (mResidentFrameArray [inSlot].mRamAddress != 0) ;
+  if (ok) {
+    enterTransmitLock () ;
+      ok = !residentFrameIsPending (inSlot) ;
+      if (ok) {
+        const uint8_t d = (1 << 0) | (1 << 1) ; // Set UINC bit, TXREQ bit
+        writeByteRegisterSPI (C1FIFOCON_REGISTER (residentTransmitFIFOIndex + inSlot) + 1, d) ;
+      }
+    leaveTransmitLock () ;
   }
-#endif
+  return ok ;
+}
 
-//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-//    POLLING (other than ESP32)
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
-#ifndef ARDUINO_ARCH_ESP32
-  void ACAN2517::poll (void) {
-    noInterrupts () ;
-    while (isr_core ()) {}
-    interrupts () ;
+bool ACAN2517::updateResidentFrameData (const uint8_t inSlot, const CANMessage & inMessage) {
+  bool ok = (inSlot < mResidentFrameCount) && (mResidentFrameArray [inSlot].mRamAddress != 0) ;
+  if (ok) {
+    ResidentFrame & frame = mResidentFrameArray [inSlot] ;
+    enterTransmitLock () ;
+      ok = !residentFrameIsPending (inSlot) ;
+      for (uint8_t i = 0 ; ok && (i < 2) ; i++) { // Only write changed data words
+        if (frame.mData32 [i] != inMessage.data32 [i]) {
+          writeRegisterSPI ((uint16_t) (frame.mRamAddress + 8 + 4 * i), inMessage.data32 [i]) ;
+          frame.mData32 [i] = inMessage.data32 [i] ;
+        }
+      }
+    leaveTransmitLock () ;
   }
-#endif
+  return ok ;
+}
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-//   INTERRUPT SERVICE ROUTINE (ESP32)
-// https://stackoverflow.com/questions/51750377/how-to-disable-interrupt-watchdog-in-esp32-or-increase-isr-time-limit
+//    PERIODIC TRANSMIT SCHEDULER
+//    Scheduler is accessed with the same mutual exclusion as tryToSend, so that tick can run in the ESP32 task.
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
-#ifdef ARDUINO_ARCH_ESP32
-  void ACAN2517::isr (void) {
-    xSemaphoreGive (mISRSemaphore) ;
+uint16_t ACAN2517::registerPeriodicFrame (const ACAN2517EncodedFrame & inFrame,
+                                          const uint32_t inPeriodMS,
+                                          const uint32_t inPhaseMS) {
+  uint16_t handle = kNoPeriodicFrame ;
+  if (mPeriodicScheduler != NULL) {
+    enterTransmitLock () ;
+      handle = mPeriodicScheduler->add (inFrame, inPeriodMS, inPhaseMS, millis ()) ;
+    leaveTransmitLock () ;
   }
-#endif
+  return handle ;
+}
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-//   INTERRUPT SERVICE ROUTINE (other than ESP32)
+
+bool ACAN2517::cancelPeriodicFrame (const uint16_t inHandle) {
+  bool ok = false ;
+  if (mPeriodicScheduler != NULL) {
+    enterTransmitLock () ;
+      ok = mPeriodicScheduler->remove (inHandle) ;
+    leaveTransmitLock () ;
+  }
+  return ok ;
+}
+
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
-#ifndef ARDUINO_ARCH_ESP32
-  void ACAN2517::isr (void) {
-    isr_core () ;
+bool ACAN2517::setPeriodicFrame (const uint16_t inHandle, const ACAN2517EncodedFrame & inFrame) {
+  bool ok = false ;
+  if (mPeriodicScheduler != NULL) {
+    enterTransmitLock () ;
+      ok = mPeriodicScheduler->setFrame (inHandle, inFrame) ;
+    leaveTransmitLock () ;
   }
-#endif
+  return ok ;
+}
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-//   INTERRUPT SERVICE ROUTINES (common)
+
+uint32_t ACAN2517::periodicFrameMissedDeadlineCount (const uint16_t inHandle) {
+  uint32_t result = 0 ;
+  if (mPeriodicScheduler != NULL) {
+    enterTransmitLock () ;
+      result = mPeriodicScheduler->missedDeadlineCount (inHandle) ;
+    leaveTransmitLock () ;
+  }
+  return result ;
+}
+
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
-bool ACAN2517::isr_core (void) {
-  bool handled = false ;
-  mSPI.beginTransaction (mSPISettings) ;
-  const uint32_t intReg = readRegisterSPI (C1INT_REGISTER) ; // DS20005688B, page 34
-  if ((intReg & (1 << 1)) != 0) { // Receive FIFO interrupt
-    receiveInterrupt () ;
-    handled = true ;
+uint32_t ACAN2517::periodicMissedDeadlineCount (void) {
+  uint32_t result = 0 ;
+  if (mPeriodicScheduler != NULL) {
+    enterTransmitLock () ;
+      result = mPeriodicScheduler->missedDeadlineCount () ;
+    leaveTransmitLock () ;
   }
-  if ((intReg & (1 << 0)) != 0) { // Transmit FIFO interrupt
-    transmitInterrupt () ;
-    handled = true ;
+  return result ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517::tick (const uint32_t inNowMS) {
+  if (mPeriodicScheduler != NULL) {
+    enterTransmitLock () ;
+      mPeriodicScheduler->startTick (inNowMS) ;
+    leaveTransmitLock () ;
+    bool loop = true ;
+    while (loop) {
+      uint16_t handle = kNoPeriodicFrame ;
+      uint32_t missedCount = 0 ;
+      enterTransmitLock () ;
+        loop = mPeriodicScheduler->nextDue (handle) ;
+        if (loop) {
+          if (!enterInTransmitBuffer (mPeriodicScheduler->frame (handle))) {
+            missedCount += 1 ;
+          }
+          missedCount += mPeriodicScheduler->reschedule (handle, inNowMS) ;
+          mPeriodicScheduler->addMissedDeadlines (handle, missedCount) ;
+        }
+      leaveTransmitLock () ;
+    //--- Call back is called outside the transaction, it can send frames
+      if ((missedCount > 0) && (mMissedDeadlineCallBack != NULL)) {
+        mMissedDeadlineCallBack (handle, missedCount) ;
+      }
+    }
   }
-  if ((intReg & (1 << 2)) != 0) { // TBCIF interrupt
-    writeByteRegisterSPI (C1INT_REGISTER, 1 << 2) ;
+  if (mReceiveDeadlineMonitor != NULL) {
+    enterReceiveLock () ;
+      mReceiveDeadlineMonitor->startCheck (inNowMS) ;
+    leaveReceiveLock () ;
+    bool loop = true ;
+    while (loop) {
+      uint16_t index = kNoMonitoredFrame ;
+      enterReceiveLock () ;
+        loop = mReceiveDeadlineMonitor->nextExpired (index) ;
+      leaveReceiveLock () ;
+      if (loop && (mReceiveDeadlineCallBack != NULL)) {
+        mReceiveDeadlineCallBack (index) ;
+      }
+    }
   }
-  if ((intReg & (1 << 3)) != 0) { // MODIF interrupt
-    writeByteRegisterSPI (C1INT_REGISTER, 1 << 3) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    RECEIVE DEADLINE MONITOR
+//    Monitor is updated by receiveInterrupt, so it is accessed with the same mutual exclusion as receive.
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint16_t ACAN2517::monitorReceiveDeadline (const tFrameFormat inFormat,
+                                           const uint32_t inIdentifier,
+                                           const uint32_t inTimeOutMS) {
+  uint16_t index = kNoMonitoredFrame ;
+  if ((mReceiveDeadlineMonitor != NULL) && ACAN2517IdentifierMap::validIdentifier (inFormat, inIdentifier)) {
+    const uint32_t key = ACAN2517IdentifierMap::key (inFormat == kExtended, inIdentifier) ;
+    enterReceiveLock () ;
+      index = mReceiveDeadlineMonitor->add (key, inTimeOutMS, millis ()) ;
+    leaveReceiveLock () ;
   }
-  if ((intReg & (1 << 12)) != 0) { // SERRIF interrupt
-    writeByteRegisterSPI (C1INT_REGISTER + 1, 1 << 4) ;
+  return index ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::receiveDeadlineExpired (const uint16_t inIndex) {
+  bool result = false ;
+  if (mReceiveDeadlineMonitor != NULL) {
+    enterReceiveLock () ;
+      result = mReceiveDeadlineMonitor->isExpired (inIndex) ;
+    leaveReceiveLock () ;
   }
-  mSPI.endTransaction () ;
-  return handled ;
+  return result ;
 }
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
-void ACAN2517::transmitInterrupt (void) {
-  CANMessage message ;
-  mDriverTransmitBuffer.remove (message) ;
-  appendInControllerTxFIFO (message) ;
-//--- If driver transmit buffer is empty, disable "FIFO not full" interrupt
-  if (mDriverTransmitBuffer.count () == 0) {
-    uint8_t d = 1 << 7 ;  // FIFO is a transmit FIFO
-    writeByteRegisterSPI (C1FIFOCON_REGISTER (2), d) ;
-    mControllerTxFIFOFull = false ;
+uint32_t ACAN2517::receiveDeadlineExpiredFlags (const uint16_t inWordIndex) {
+  uint32_t result = 0 ;
+  if (mReceiveDeadlineMonitor != NULL) {
+    enterReceiveLock () ;
+      result = mReceiveDeadlineMonitor->expiredFlags (inWordIndex) ;
+    leaveReceiveLock () ;
   }
+  return result ;
 }
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
-void ACAN2517::receiveInterrupt (void) {
-  readByteRegisterSPI (C1FIFOSTA_REGISTER (receiveFIFOIndex)) ;
-  const uint16_t ramAddress = (uint16_t) (0x400 + readRegisterSPI (C1FIFOUA_REGISTER (receiveFIFOIndex))) ;
-  CANMessage message ;
-  assertCS () ;
+uint32_t ACAN2517::receiveDeadlineExpirationCount (void) {
+  uint32_t result = 0 ;
+  if (mReceiveDeadlineMonitor != NULL) {
+    enterReceiveLock () ;
+      result = mReceiveDeadlineMonitor->expirationCount () ;
+    leaveReceiveLock () ;
+  }
+  return result ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    FILTER STATISTICS
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::getFilterStatistics (FilterStatistics & outStatistics, const bool inReset) {
+  const bool ok = mFilterStatistics != NULL ;
+  if (ok) {
+    enterReceiveLock () ;
+      outStatistics = *mFilterStatistics ;
+      if (inReset) {
+        *mFilterStatistics = FilterStatistics () ;
+      }
+    leaveReceiveLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::resetFilterStatistics (void) {
+  const bool ok = mFilterStatistics != NULL ;
+  if (ok) {
+    enterReceiveLock () ;
+      *mFilterStatistics = FilterStatistics () ;
+    leaveReceiveLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    DENY LIST
+//    Deny list is read by receiveInterrupt, so it is accessed with the same mutual exclusion as receive.
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::denyFrame (const tFrameFormat inFormat, const uint32_t inIdentifier) {
+  bool ok = (mDenyList != NULL) && ACAN2517IdentifierMap::validIdentifier (inFormat, inIdentifier) ;
+  if (ok) {
+    enterReceiveLock () ;
+      ok = mDenyList->add (inFormat == kExtended, inIdentifier) ;
+    leaveReceiveLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::allowFrame (const tFrameFormat inFormat, const uint32_t inIdentifier) {
+  bool ok = (mDenyList != NULL) && ACAN2517IdentifierMap::validIdentifier (inFormat, inIdentifier) ;
+  if (ok) {
+    enterReceiveLock () ;
+      ok = mDenyList->remove (inFormat == kExtended, inIdentifier) ;
+    leaveReceiveLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::deniedFrameCount (void) {
+  enterReceiveLock () ;
+    const uint32_t result = mDeniedFrameCount ;
+  leaveReceiveLock () ;
+  return result ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    CONTENT FILTER
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::appendContentFilter (const tFrameFormat inFormat,
+                                    const uint32_t inIdentifierMask,
+                                    const uint32_t inIdentifierAcceptance,
+                                    const uint64_t inDataMask,
+                                    const uint64_t inDataValue) {
+  bool ok = (mContentFilter != NULL)
+    && ACAN2517IdentifierMap::validIdentifier (inFormat, inIdentifierMask)
+    && ACAN2517IdentifierMap::validIdentifier (inFormat, inIdentifierAcceptance)
+  ;
+  if (ok) {
+    enterReceiveLock () ;
+      ok = mContentFilter->append (ACAN2517IdentifierMap::key (true, inIdentifierMask), // Format bit is matched
+                                   ACAN2517IdentifierMap::key (inFormat == kExtended, inIdentifierAcceptance),
+                                   inDataMask,
+                                   inDataValue) ;
+    leaveReceiveLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::contentRejectedFrameCount (void) {
+  enterReceiveLock () ;
+    const uint32_t result = mContentRejectedFrameCount ;
+  leaveReceiveLock () ;
+  return result ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    CHANGE ONLY DELIVERY
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::deliverOnChange (const tFrameFormat inFormat,
+                                const uint32_t inIdentifier,
+                                const uint32_t inRefreshIntervalMS) {
+  bool ok = (mChangeOnlyTable != NULL) && ACAN2517IdentifierMap::validIdentifier (inFormat, inIdentifier) ;
+  if (ok) {
+    enterReceiveLock () ;
+      ok = mChangeOnlyTable->add (ACAN2517IdentifierMap::key (inFormat == kExtended, inIdentifier),
+                                  inRefreshIntervalMS) ;
+    leaveReceiveLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::unchangedFrameCount (void) {
+  enterReceiveLock () ;
+    const uint32_t result = mUnchangedFrameCount ;
+  leaveReceiveLock () ;
+  return result ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    RECEIVE DECIMATION
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::decimateFrame (const tFrameFormat inFormat,
+                              const uint32_t inIdentifier,
+                              const uint16_t inRatio) {
+  bool ok = (mDecimationTable != NULL) && ACAN2517IdentifierMap::validIdentifier (inFormat, inIdentifier) ;
+  if (ok) {
+    enterReceiveLock () ;
+      ok = mDecimationTable->add (ACAN2517IdentifierMap::key (inFormat == kExtended, inIdentifier), inRatio, 0) ;
+    leaveReceiveLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::limitFrameRate (const tFrameFormat inFormat,
+                               const uint32_t inIdentifier,
+                               const uint32_t inMinIntervalUS) {
+  bool ok = (mDecimationTable != NULL) && ACAN2517IdentifierMap::validIdentifier (inFormat, inIdentifier) ;
+  if (ok) {
+    enterReceiveLock () ;
+      ok = mDecimationTable->add (ACAN2517IdentifierMap::key (inFormat == kExtended, inIdentifier),
+                                  1,
+                                  inMinIntervalUS) ;
+    leaveReceiveLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::decimatedFrameCount (void) {
+  enterReceiveLock () ;
+    const uint32_t result = mDecimatedFrameCount ;
+  leaveReceiveLock () ;
+  return result ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    MAILBOXES
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint16_t ACAN2517::registerMailbox (const tFrameFormat inFormat, const uint32_t inIdentifier) {
+  uint16_t mailbox = kNoMailbox ;
+  if ((mMailboxTable != NULL) && ACAN2517IdentifierMap::validIdentifier (inFormat, inIdentifier)) {
+    enterReceiveLock () ;
+      mailbox = mMailboxTable->add (ACAN2517IdentifierMap::key (inFormat == kExtended, inIdentifier)) ;
+    leaveReceiveLock () ;
+  }
+  return mailbox ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::readMailbox (const uint16_t inMailbox, CANMessage & outMessage, uint32_t & outSequence) const {
+  return (mMailboxTable != NULL) && mMailboxTable->read (inMailbox, outMessage, outSequence) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    USER RECEIVE RING
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::setReceiveRing (CANMessage inStorage [],
+                               const uint32_t inCapacity,
+                               volatile uint32_t * ioWriteIndex,
+                               volatile uint32_t * ioReadIndex) {
+  const bool ok = (inStorage == NULL) || (
+    (inCapacity >= 2) && (ioWriteIndex != NULL) && (ioReadIndex != NULL)
+    && (*ioWriteIndex < inCapacity) && (*ioReadIndex < inCapacity)
+  ) ;
+  if (ok) {
+    enterReceiveLock () ;
+      mReceiveRing = inStorage ;
+      mReceiveRingCapacity = (inStorage == NULL) ? 0 : inCapacity ;
+      mReceiveRingWriteIndex = (inStorage == NULL) ? NULL : ioWriteIndex ;
+      mReceiveRingReadIndex = (inStorage == NULL) ? NULL : ioReadIndex ;
+      if (!receiveSinkIsFull ()) { // Enable "FIFO  not empty" interrupt
+        writeByteRegisterSPI (C1FIFOCON_REGISTER (receiveFIFOIndex), receiveFIFOInterruptsEnabled) ;
+      }
+    leaveReceiveLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517::notifyReceiveRingConsumed (void) {
+  enterReceiveLock () ;
+    if ((mReceiveRing != NULL) && !receiveSinkIsFull ()) { // Enable "FIFO  not empty" interrupt
+      writeByteRegisterSPI (C1FIFOCON_REGISTER (receiveFIFOIndex), receiveFIFOInterruptsEnabled) ;
+    }
+  leaveReceiveLock () ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::receiveSinkIsFull (void) const {
+  bool full ;
+  if (mReceiveRing != NULL) {
+    uint32_t nextWriteIndex = *mReceiveRingWriteIndex + 1 ;
+    if (nextWriteIndex == mReceiveRingCapacity) {
+      nextWriteIndex = 0 ;
+    }
+    full = nextWriteIndex == *mReceiveRingReadIndex ;
+  }else if (mRawReceiveBuffer != NULL) {
+    full = mRawReceiveBuffer->count () == mRawReceiveBuffer->size () ;
+  }else{
+    full = mDriverReceiveBuffer.count () == mDriverReceiveBuffer.size () ;
+  }
+  return full ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::receiveBufferCount (void) const {
+  return (mRawReceiveBuffer != NULL) ? mRawReceiveBuffer->count () : mDriverReceiveBuffer.count () ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    WATERMARKS
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517::setReceiveWatermarks (const uint32_t inHighWatermark,
+                                     const uint32_t inLowWatermark,
+                                     const tWatermarkCallBack inCallBack) {
+  enterReceiveLock () ;
+    mReceiveWatermark.set (inHighWatermark, inLowWatermark, inCallBack) ;
+    mReceiveWatermark.update (receiveBufferCount ()) ;
+  leaveReceiveLock () ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517::setTransmitWatermarks (const uint32_t inHighWatermark,
+                                      const uint32_t inLowWatermark,
+                                      const tWatermarkCallBack inCallBack) {
+  enterReceiveLock () ; // Also excludes transmitInterrupt
+    mTransmitWatermark.set (inHighWatermark, inLowWatermark, inCallBack) ;
+    mTransmitWatermark.update (mDriverTransmitBuffer.count ()) ;
+  leaveReceiveLock () ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::receiveSinkHasRoom (void) const {
+  return !receiveSinkIsFull ()
+    || ((mReceiveOverflowPolicy == ACAN2517Settings::DropOldest) && (mReceiveRing == NULL))
+  ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517::makeRoomInReceiveSink (void) {
+  if ((mReceiveOverflowPolicy == ACAN2517Settings::DropOldest) && receiveSinkIsFull ()) {
+    mDriverReceiveDropCount = mDriverReceiveDropCount + 1 ;
+    mDroppedOldestCount += 1 ;
+    if (mRawReceiveBuffer != NULL) {
+      mRawReceiveBuffer->consume (1) ;
+    }else{
+      mDriverReceiveBuffer.consume (1) ;
+    }
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    RECEIVE PIPELINE (called by receiveInterrupt)
+//    Throttles are called once room in the receive sink is known, so that their state (decimation dates and
+//    counters, change only reference payload) only advances for delivered messages.
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::passesReceiveFilters (const CANMessage & inMessage) {
+  bool accepted = true ;
+//--- Deny list
+  if ((mDenyList != NULL) && mDenyList->contains (inMessage)) {
+    mDeniedFrameCount += 1 ;
+    accepted = false ;
+  }
+//--- Content filter
+  if (accepted && (mContentFilter != NULL) && !mContentFilter->accepts (inMessage)) {
+    mContentRejectedFrameCount += 1 ;
+    accepted = false ;
+  }
+  return accepted ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::passesReceiveThrottles (const CANMessage & inMessage) {
+  bool accepted = true ;
+//--- Decimation
+  if ((mDecimationTable != NULL) && mDecimationTable->drops (inMessage, micros ())) {
+    mDecimatedFrameCount += 1 ;
+    accepted = false ;
+  }
+//--- Change only delivery
+  if (accepted && (mChangeOnlyTable != NULL) && mChangeOnlyTable->isRepeat (inMessage, millis ())) {
+    mUnchangedFrameCount += 1 ;
+    accepted = false ;
+  }
+//---
+  return accepted ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    RECEIVE FRAME
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+//   Mutual exclusion with receiveInterrupt
+
+void ACAN2517::enterReceiveLock (void) {
+  #ifdef ARDUINO_ARCH_ESP32
+    mSPI.beginTransaction (mSPISettings) ; // For ensuring mutual exclusion access
+  #else
+    noInterrupts () ;
+  #endif
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517::leaveReceiveLock (void) {
+  #ifdef ARDUINO_ARCH_ESP32
+    mSPI.endTransaction () ;
+  #else
+    interrupts () ;
+  #endif
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//   Mutual exclusion with the interrupt service routine, for accessing the transmit state and the controller
+
+void ACAN2517::enterTransmitLock (void) {
+//--- Workaround: the Teensy 3.5 / 3.6 "SPI.usingInterrupt" bug (https://github.com/PaulStoffregen/SPI/issues/35)
+  #if (defined (__MK64FX512__) || defined (__MK66FX1M0__))
+    noInterrupts () ;
+  #endif
+  mSPI.beginTransaction (mSPISettings) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517::leaveTransmitLock (void) {
+  mSPI.endTransaction () ;
+  #if (defined (__MK64FX512__) || defined (__MK66FX1M0__))
+    interrupts () ;
+  #endif
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::available (void) {
+  enterReceiveLock () ;
+    const bool hasReceivedMessage = (mRawReceiveBuffer != NULL)
+      ? (mRawReceiveBuffer->count () > 0)
+      : (mDriverReceiveBuffer.count () > 0)
+    ;
+  leaveReceiveLock () ;
+  return hasReceivedMessage ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::receive (CANMessage & outMessage) {
+  enterReceiveLock () ;
+    const bool hasReceivedMessage = (mRawReceiveBuffer != NULL)
+      ? mRawReceiveBuffer->remove (outMessage)
+      : mDriverReceiveBuffer.remove (outMessage)
+    ;
+    if (hasReceivedMessage) { // Receive FIFO is not full, enable "FIFO  not empty" interrupt
+      writeByteRegisterSPI (C1FIFOCON_REGISTER (receiveFIFOIndex), receiveFIFOInterruptsEnabled) ;
+    }
+    mReceiveWatermark.update (receiveBufferCount ()) ;
+  leaveReceiveLock () ;
+//---
+  return hasReceivedMessage ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::receive (CANMessage & outMessage, const uint32_t inTimeOutMS) {
+  bool hasReceivedMessage = receive (outMessage) ;
+  #ifdef ARDUINO_ARCH_ESP32
+    const TickType_t start = xTaskGetTickCount () ;
+    const TickType_t timeOut = pdMS_TO_TICKS (inTimeOutMS) ;
+    TickType_t elapsed = 0 ;
+    while (!hasReceivedMessage && (elapsed < timeOut)) {
+      xSemaphoreTake (mReceiveSemaphore, timeOut - elapsed) ; // A stale give only causes an extra loop
+      hasReceivedMessage = receive (outMessage) ;
+      elapsed = xTaskGetTickCount () - start ;
+    }
+  #else
+    const uint32_t start = millis () ;
+    while (!hasReceivedMessage && ((millis () - start) < inTimeOutMS)) {
+      hasReceivedMessage = receive (outMessage) ;
+    }
+  #endif
+  return hasReceivedMessage ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::peekContiguousWithinLock (const CANMessage * & outFirstMessage) {
+  mDroppedOldestCount = 0 ;
+  uint32_t count ;
+  if (mRawReceiveBuffer != NULL) { // Deferred decoding: only head is decoded, in mPeekedMessage
+    count = mRawReceiveBuffer->decodeHead (mPeekedMessage) ? 1 : 0 ;
+    outFirstMessage = (count > 0) ? & mPeekedMessage : NULL ;
+  }else if (mReceiveOverflowPolicy == ACAN2517Settings::DropOldest) { // Head may be overwritten: it is copied
+    const CANMessage * head = mDriverReceiveBuffer.head () ;
+    count = (head != NULL) ? 1 : 0 ;
+    if (head != NULL) {
+      mPeekedMessage = *head ;
+    }
+    outFirstMessage = (head != NULL) ? & mPeekedMessage : NULL ;
+  }else{
+    outFirstMessage = mDriverReceiveBuffer.head () ;
+    count = mDriverReceiveBuffer.contiguousCount () ;
+  }
+  return count ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::consumeWithinLock (const uint32_t inCount) {
+//--- Peeked messages dropped by DropOldest are already removed
+  const uint32_t count = (inCount > mDroppedOldestCount) ? (inCount - mDroppedOldestCount) : 0 ;
+  mDroppedOldestCount = 0 ;
+  const uint32_t removedCount = (mRawReceiveBuffer != NULL)
+    ? mRawReceiveBuffer->consume (count)
+    : mDriverReceiveBuffer.consume (count)
+  ;
+  if (removedCount > 0) { // Receive FIFO is not full, enable "FIFO  not empty" interrupt
+    writeByteRegisterSPI (C1FIFOCON_REGISTER (receiveFIFOIndex), receiveFIFOInterruptsEnabled) ;
+  }
+  mReceiveWatermark.update (receiveBufferCount ()) ;
+  return removedCount ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+const CANMessage * ACAN2517::peek (void) {
+  const CANMessage * result ;
+  enterReceiveLock () ;
+    peekContiguousWithinLock (result) ;
+  leaveReceiveLock () ;
+  return result ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::peekContiguous (const CANMessage * & outFirstMessage) {
+  enterReceiveLock () ;
+    const uint32_t count = peekContiguousWithinLock (outFirstMessage) ;
+  leaveReceiveLock () ;
+  return count ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::consume (const uint32_t inCount) {
+  enterReceiveLock () ;
+    const uint32_t removedCount = consumeWithinLock (inCount) ;
+  leaveReceiveLock () ;
+  return removedCount ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::receiveBatch (CANMessage outMessages [], const uint32_t inMaxCount) {
+  uint32_t count = 0 ;
+  enterReceiveLock () ;
+    if (mRawReceiveBuffer != NULL) {
+      while ((count < inMaxCount) && mRawReceiveBuffer->remove (outMessages [count])) {
+        count += 1 ;
+      }
+    }else{
+      while ((count < inMaxCount) && mDriverReceiveBuffer.remove (outMessages [count])) {
+        count += 1 ;
+      }
+    }
+    if (count > 0) { // Receive FIFO is not full, enable "FIFO  not empty" interrupt
+      writeByteRegisterSPI (C1FIFOCON_REGISTER (receiveFIFOIndex), receiveFIFOInterruptsEnabled) ;
+    }
+    mReceiveWatermark.update (receiveBufferCount ()) ;
+  leaveReceiveLock () ;
+  return count ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::dispatchAll (const uint32_t inMaxCount, const uint32_t inMaxMicros) {
+  const uint32_t start = micros () ;
+  uint32_t dispatchedCount = 0 ;
+  uint32_t n = 0 ; // Dispatched messages of the current span, consumed when the next span is peeked
+  bool budgetExhausted = inMaxCount == 0 ;
+  while (!budgetExhausted) {
+  //--- A single lock per span: consume the previous span, peek the next one
+    const CANMessage * messages ;
+    enterReceiveLock () ;
+      consumeWithinLock (n) ;
+      const uint32_t spanCount = peekContiguousWithinLock (messages) ;
+    leaveReceiveLock () ;
+  //--- Messages of the span are not written by receiveInterrupt until they are consumed
+    n = 0 ;
+    budgetExhausted = spanCount == 0 ;
+    while ((n < spanCount) && !budgetExhausted) {
+      dispatchToCallBack (messages [n]) ;
+      n += 1 ;
+      budgetExhausted = ((dispatchedCount + n) >= inMaxCount)
+        || ((inMaxMicros > 0) && ((micros () - start) >= inMaxMicros)) ;
+    }
+    dispatchedCount += n ;
+  }
+  if (n > 0) { // Budget exhausted within a span
+    consume (n) ;
+  }
+  return dispatchedCount ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::dispatchReceivedMessage (const tFilterMatchCallBack inFilterMatchCallBack) {
+//--- A single lock (peek then consume would take it twice); the copy is cheaper than a lock round trip
+  CANMessage receivedMessage ;
+  const bool hasReceived = receive (receivedMessage) ;
+  if (hasReceived) {
+    if (NULL != inFilterMatchCallBack) {
+      inFilterMatchCallBack (receivedMessage.idx) ;
+    }
+    dispatchToCallBack (receivedMessage) ;
+  }
+  return hasReceived ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517::dispatchToCallBack (const CANMessage & inMessage, const bool inUsesSoftwareDispatchTable) {
+  const uint32_t filterIndex = inMessage.idx ;
+  if (mCallBackWithContextArray [filterIndex].mCallBackRoutine != NULL) {
+    const CallBackWithContext & entry = mCallBackWithContextArray [filterIndex] ;
+    entry.mCallBackRoutine (inMessage, entry.mContext) ;
+  }else{
+    ACANCallBackRoutine callBackFunction = NULL ;
+    if (mCallBackFunctionArray != NULL) {
+      callBackFunction = mCallBackFunctionArray [filterIndex] ;
+    }else if (filterIndex < mConstantFilterCount) {
+      callBackFunction = mConstantFilterTable [filterIndex].mCallBackRoutine ;
+    }
+    if ((NULL == callBackFunction) && (NULL != mSoftwareDispatchTable) && inUsesSoftwareDispatchTable) {
+      callBackFunction = mSoftwareDispatchTable->callBack (inMessage) ;
+    }
+    if (NULL != callBackFunction) {
+      callBackFunction (inMessage) ;
+    }
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::setFilterCallBack (const uint8_t inFilterIndex,
+                                  const tCallBackRoutineWithContext inCallBackRoutine,
+                                  void * inContext) {
+  const bool ok = inFilterIndex < 32 ;
+  if (ok) {
+    enterReceiveLock () ; // The call back of an immediate filter is called by receiveInterrupt
+      mCallBackWithContextArray [inFilterIndex].mContext = inContext ;
+      mCallBackWithContextArray [inFilterIndex].mCallBackRoutine = inCallBackRoutine ;
+    leaveReceiveLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::setImmediateFilter (const uint8_t inFilterIndex, const bool inImmediate) {
+  const bool ok = inFilterIndex < 32 ;
+  if (ok) {
+    const uint32_t bit = ((uint32_t) 1) << inFilterIndex ;
+    enterTransmitLock () ; // Also excludes receiveInterrupt
+      mImmediateFilters = inImmediate ? (mImmediateFilters | bit) : (mImmediateFilters & ~ bit) ;
+    //--- An enabled filter is disabled while its FIFO is changed (DS20005688B, page 58)
+      if ((readByteRegisterSPI (C1FLTCON_REGISTER (inFilterIndex)) & (1 << 7)) != 0) {
+        writeByteRegisterSPI (C1FLTCON_REGISTER (inFilterIndex), 1) ; // Filter is disabled
+        writeByteRegisterSPI (C1FLTCON_REGISTER (inFilterIndex), filterControl (inFilterIndex)) ;
+      }
+    leaveTransmitLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint8_t ACAN2517::filterControl (const uint8_t inFilterIndex) const {
+  const bool immediate = (mImmediateFilters & (((uint32_t) 1) << inFilterIndex)) != 0 ;
+  return (1 << 7) | (immediate ? mImmediateReceiveFIFOIndex : receiveFIFOIndex) ; // Filter is enabled, and its FIFO
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    RUNTIME FILTER UPDATE
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::replaceFilter (const uint8_t inFilterIndex,
+                                  const tFrameFormat inFormat,
+                                  const uint32_t inMask,
+                                  const uint32_t inAcceptance,
+                                  const ACANCallBackRoutine inCallBackRoutine) {
+  uint32_t errorCode = 0 ;
+  if (inFilterIndex >= 32) {
+    errorCode |= kFilterIndexGreaterThan31 ;
+  }
+  if (ACAN2517Filters::checkFilter (inFormat, inMask, inAcceptance) != ACAN2517Filters::kFiltersOk) {
+    errorCode |= kFilterDefinitionError ;
+  }
+//--- Constant filters: call back routines are copied once in a writable array
+  if ((errorCode == 0) && (mCallBackFunctionArray == NULL)) {
+    ACANCallBackRoutine * callBackFunctionArray = new ACANCallBackRoutine [32] ;
+    for (uint8_t i = 0 ; i < 32 ; i++) {
+      callBackFunctionArray [i] = (i < mConstantFilterCount) ? mConstantFilterTable [i].mCallBackRoutine : NULL ;
+    }
+    mCallBackFunctionArray = callBackFunctionArray ;
+  }
+  if (errorCode == 0) {
+    enterTransmitLock () ;
+      writeByteRegisterSPI (C1FLTCON_REGISTER (inFilterIndex), 1) ; // Filter is disabled (DS20005688B, page 58)
+      writeRegisterSPI (C1MASK_REGISTER (inFilterIndex), ACAN2517Filters::filterMask (inFormat, inMask)) ;
+      writeRegisterSPI (C1FLTOBJ_REGISTER (inFilterIndex), ACAN2517Filters::acceptanceFilter (inFormat, inAcceptance)) ;
+      mCallBackFunctionArray [inFilterIndex] = inCallBackRoutine ;
+      writeByteRegisterSPI (C1FLTCON_REGISTER (inFilterIndex), filterControl (inFilterIndex)) ;
+      mConfiguredFilters |= ((uint32_t) 1) << inFilterIndex ;
+    leaveTransmitLock () ;
+  }
+  return errorCode ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::replaceFrameFilter (const uint8_t inFilterIndex,
+                                       const tFrameFormat inFormat,
+                                       const uint32_t inIdentifier,
+                                       const ACANCallBackRoutine inCallBackRoutine) {
+  const uint32_t mask = ACAN2517IdentifierMap::maxIdentifier (inFormat) ; // All identifier bits are compared
+  return replaceFilter (inFilterIndex, inFormat, mask, inIdentifier, inCallBackRoutine) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::enableFilter (const uint8_t inFilterIndex) {
+//--- A filter that has never been programmed has a reset mask (0): it would accept every frame
+  const bool ok = (inFilterIndex < 32) && ((mConfiguredFilters & (((uint32_t) 1) << inFilterIndex)) != 0) ;
+  if (ok) {
+    enterTransmitLock () ;
+      writeByteRegisterSPI (C1FLTCON_REGISTER (inFilterIndex), filterControl (inFilterIndex)) ; // DS20005688B, page 58
+    leaveTransmitLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::disableFilter (const uint8_t inFilterIndex) {
+  const bool ok = inFilterIndex < 32 ;
+  if (ok) {
+    enterTransmitLock () ;
+      writeByteRegisterSPI (C1FLTCON_REGISTER (inFilterIndex), 1) ; // Filter is disabled (DS20005688B, page 58)
+    leaveTransmitLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    SOFTWARE DISPATCH TABLE
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::appendSoftwareFrameFilter (const tFrameFormat inFormat,
+                                          const uint32_t inIdentifier,
+                                          const ACANCallBackRoutine inCallBackRoutine) {
+  bool ok = (mSoftwareDispatchTable != NULL) && ACAN2517IdentifierMap::validIdentifier (inFormat, inIdentifier) ;
+  if (ok) {
+    enterReceiveLock () ; // Hits are counted by receiveInterrupt
+      ok = mSoftwareDispatchTable->appendFrame (ACAN2517IdentifierMap::key (inFormat == kExtended, inIdentifier),
+                                                inCallBackRoutine) ;
+    leaveReceiveLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::appendSoftwareFilter (const tFrameFormat inFormat,
+                                     const uint32_t inMask,
+                                     const uint32_t inAcceptance,
+                                     const ACANCallBackRoutine inCallBackRoutine) {
+  const bool extended = inFormat == kExtended ;
+  bool ok = (mSoftwareDispatchTable != NULL)
+    && ACAN2517IdentifierMap::validIdentifier (inFormat, inMask)
+    && ACAN2517IdentifierMap::validIdentifier (inFormat, inAcceptance)
+  ;
+  if (ok) {
+    enterReceiveLock () ;
+      ok = mSoftwareDispatchTable->appendMaskRule (ACAN2517IdentifierMap::key (true, inMask), // Format bit is matched
+                                                   ACAN2517IdentifierMap::key (extended, inAcceptance),
+                                                   inCallBackRoutine) ;
+    leaveReceiveLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517::softwareRejectedFrameCount (void) const {
+  return (mSoftwareDispatchTable == NULL) ? 0 : mSoftwareDispatchTable->rejectedFrameCount () ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    ADAPTIVE FILTER PLACEMENT
+//    Hit counts are updated by receiveInterrupt; they are statistics, so rebalanceFilters reads them without
+//    mutual exclusion, but halves them, and reads the software table entry count, in mutual exclusion.
+//    rebalanceFilters runs in the caller context (never in tick), as compiling cost grows as O(n^3).
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::setAdaptiveFilterPlacement (const uint8_t inFirstFilterIndex,
+                                           const uint8_t inHotFilterCount,
+                                           const uint32_t inPeriodMS) {
+  const bool ok = (mSoftwareDispatchTable != NULL)
+    && (inFirstFilterIndex < 32)
+    && ((inHotFilterCount + 2) <= (32 - inFirstFilterIndex))
+  ;
+  if (ok) {
+    delete mAdaptiveFilterCompiler ;
+    mAdaptiveFilterCompiler = new ACAN2517FilterCompiler (mSoftwareDispatchTable->frameCapacity ()) ;
+    delete [] mAdaptiveHotIndexes ;
+    mAdaptiveHotIndexes = new uint16_t [inHotFilterCount + 1] ; // One more for insertion
+    delete [] mAdaptiveFilters ;
+    mAdaptiveFilters = new AdaptiveFilter [32 - inFirstFilterIndex] ; // Not written yet
+    enterReceiveLock () ; // Read by receiveInterrupt
+      mAdaptiveFirstFilterIndex = inFirstFilterIndex ;
+    leaveReceiveLock () ;
+    mAdaptiveHotFilterCount = inHotFilterCount ;
+    mAdaptivePeriodMS = inPeriodMS ;
+    mAdaptiveRebalanceDate = millis () ;
+    rebalanceFilters () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::updateFilterPlacement (void) {
+  const uint32_t now = millis () ;
+  const bool due = (mAdaptivePeriodMS > 0) && ((now - mAdaptiveRebalanceDate) >= mAdaptivePeriodMS) ;
+  if (due) {
+    mAdaptiveRebalanceDate = now ;
+    rebalanceFilters () ;
+  }
+  return due ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517::placeAdaptiveFilter (const uint8_t inFilterIndex,
+                                    const tFrameFormat inFormat,
+                                    const uint32_t inMask,
+                                    const uint32_t inAcceptance) {
+  AdaptiveFilter & filter = mAdaptiveFilters [inFilterIndex - mAdaptiveFirstFilterIndex] ;
+  const bool extended = inFormat == kExtended ;
+  const bool changed = !filter.mWritten
+    || !filter.mEnabled
+    || (filter.mExtended != extended)
+    || (filter.mMask != inMask)
+    || (filter.mAcceptance != inAcceptance)
+  ;
+  if (changed) {
+    replaceFilter (inFilterIndex, inFormat, inMask, inAcceptance, NULL) ;
+    filter.mMask = inMask ;
+    filter.mAcceptance = inAcceptance ;
+    filter.mExtended = extended ;
+    filter.mEnabled = true ;
+    filter.mWritten = true ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::rebalanceFilters (void) {
+  const bool ok = mAdaptiveFilterCompiler != NULL ;
+  if (ok) {
+  //--- Entries are only appended: entries 0 ... frameCount - 1 do not change during rebalancing
+    enterReceiveLock () ;
+      const uint16_t frameCount = mSoftwareDispatchTable->frameCount () ;
+    leaveReceiveLock () ;
+  //--- Select hot identifiers (insertion in a list sorted by decreasing hit count), O(frameCount * hotCount);
+  //    identifiers without hit are never hot
+    uint8_t hotCount = 0 ;
+    for (uint16_t i = 0 ; i < frameCount ; i++) {
+      const uint32_t hitCount = mSoftwareDispatchTable->frameHitCount (i) ;
+      if (hitCount > 0) {
+        uint8_t k = hotCount ;
+        while ((k > 0) && (mSoftwareDispatchTable->frameHitCount (mAdaptiveHotIndexes [k - 1]) < hitCount)) {
+          mAdaptiveHotIndexes [k] = mAdaptiveHotIndexes [k - 1] ;
+          k -= 1 ;
+        }
+        mAdaptiveHotIndexes [k] = i ;
+        if (hotCount < mAdaptiveHotFilterCount) {
+          hotCount += 1 ;
+        }
+      }
+    }
+  //--- Compile cold identifiers
+    const uint8_t coldFilterCapacity = (uint8_t) (32 - mAdaptiveFirstFilterIndex - hotCount) ;
+    mAdaptiveFilterCompiler->clear () ;
+    for (uint16_t i = 0 ; i < frameCount ; i++) {
+      bool hot = false ;
+      for (uint8_t k = 0 ; (k < hotCount) && !hot ; k++) {
+        hot = mAdaptiveHotIndexes [k] == i ;
+      }
+      if (!hot) {
+        const uint32_t key = mSoftwareDispatchTable->frameKey (i) ;
+        const bool extended = (key >> 31) != 0 ;
+        mAdaptiveFilterCompiler->appendFrame (extended ? kExtended : kStandard, key & 0x1FFFFFFF) ;
+      }
+    }
+    mAdaptiveFilterCompiler->compile (coldFilterCapacity) ;
+  //--- Write hot filters, then cold filters, only if they have changed; call back routines are NULL, the
+  //    software table dispatches
+    uint8_t filterIndex = mAdaptiveFirstFilterIndex ;
+    for (uint8_t k = 0 ; k < hotCount ; k++) {
+      const uint32_t key = mSoftwareDispatchTable->frameKey (mAdaptiveHotIndexes [k]) ;
+      const bool extended = (key >> 31) != 0 ;
+      const tFrameFormat format = extended ? kExtended : kStandard ;
+      placeAdaptiveFilter (filterIndex, format, ACAN2517IdentifierMap::maxIdentifier (format), key & 0x1FFFFFFF) ;
+      filterIndex += 1 ;
+    }
+    for (uint16_t i = 0 ; i < mAdaptiveFilterCompiler->filterCount () ; i++) {
+      tFrameFormat format = kStandard ;
+      uint32_t mask = 0 ;
+      uint32_t acceptance = 0 ;
+      mAdaptiveFilterCompiler->getFilter (i, format, mask, acceptance) ;
+      placeAdaptiveFilter (filterIndex, format, mask, acceptance) ;
+      filterIndex += 1 ;
+    }
+    while (filterIndex < 32) {
+      AdaptiveFilter & filter = mAdaptiveFilters [filterIndex - mAdaptiveFirstFilterIndex] ;
+      if (!filter.mWritten || filter.mEnabled) {
+        disableFilter (filterIndex) ;
+        filter.mEnabled = false ;
+        filter.mWritten = true ;
+      }
+      filterIndex += 1 ;
+    }
+  //--- Follow recent traffic
+    enterReceiveLock () ;
+      mSoftwareDispatchTable->decayFrameHitCounts () ;
+    leaveReceiveLock () ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    POLLING (ESP32)
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef ARDUINO_ARCH_ESP32
+  void ACAN2517::poll (void) {
+    xSemaphoreGive (mISRSemaphore) ;
+  }
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    POLLING (other than ESP32)
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  void ACAN2517::poll (void) {
+    noInterrupts () ;
+    while (isr_core ()) {}
+    interrupts () ;
+    tick (millis ()) ;
+  }
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//   INTERRUPT SERVICE ROUTINE (ESP32)
+// https://stackoverflow.com/questions/51750377/how-to-disable-interrupt-watchdog-in-esp32-or-increase-isr-time-limit
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef ARDUINO_ARCH_ESP32
+  void ACAN2517::isr (void) {
+    xSemaphoreGive (mISRSemaphore) ;
+  }
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//   INTERRUPT SERVICE ROUTINE (other than ESP32)
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ARDUINO_ARCH_ESP32
+  void ACAN2517::isr (void) {
+    isr_core () ;
+  }
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//   INTERRUPT SERVICE ROUTINES (common)
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517::isr_core (void) {
+  bool handled = false ;
+  mSPI.beginTransaction (mSPISettings) ;
+  const uint32_t intReg = readRegisterSPI (C1INT_REGISTER) ; // DS20005688B, page 34
+  if ((intReg & (1 << 1)) != 0) { // Receive FIFO interrupt
+  //--- Without immediate receive FIFO, the receive FIFO is the only one with receive interrupts
+    uint32_t receiveFIFOs = ((uint32_t) 1) << receiveFIFOIndex ;
+    if (mImmediateReceiveFIFOIndex != receiveFIFOIndex) {
+      receiveFIFOs = readRegisterSPI (C1RXIF_REGISTER) ; // DS20005688B, page 38
+    }
+  //--- Immediate receive FIFO is served even if receive sink is full
+    if ((mImmediateReceiveFIFOIndex != receiveFIFOIndex)
+     && ((receiveFIFOs & (((uint32_t) 1) << mImmediateReceiveFIFOIndex)) != 0)) {
+      receiveInterrupt (mImmediateReceiveFIFOIndex) ;
+    }
+    if ((receiveFIFOs & (((uint32_t) 1) << receiveFIFOIndex)) != 0) {
+      if ((mReceiveOverflowPolicy == ACAN2517Settings::Backpressure) && receiveSinkIsFull ()) {
+      //--- Leave message in controller receive FIFO, disable "FIFO not empty" interrupt
+        writeByteRegisterSPI (C1FIFOCON_REGISTER (receiveFIFOIndex), receiveFIFONotEmptyInterruptDisabled) ;
+      }else{
+        receiveInterrupt (receiveFIFOIndex) ;
+        #ifdef ARDUINO_ARCH_ESP32
+          xSemaphoreGive (mReceiveSemaphore) ; // Wake up a task blocked in receive
+        #endif
+      }
+    }
+    handled = true ;
+  }
+  if ((intReg & (1 << 0)) != 0) { // Transmit FIFO interrupt
+    transmitInterrupt () ;
+    #ifdef ARDUINO_ARCH_ESP32
+      xSemaphoreGive (mTransmitSemaphore) ; // Wake up a task blocked in send
+    #endif
+    handled = true ;
+  }
+  if ((intReg & (1 << 2)) != 0) { // TBCIF interrupt
+    writeByteRegisterSPI (C1INT_REGISTER, 1 << 2) ;
+  }
+  if ((intReg & (1 << 3)) != 0) { // MODIF interrupt
+    writeByteRegisterSPI (C1INT_REGISTER, 1 << 3) ;
+  }
+  if ((intReg & (1 << 11)) != 0) { // RXOVIF interrupt
+    const uint32_t overflowFIFOs = readRegisterSPI (C1RXOVIF_REGISTER) ; // DS20005688B, page 39
+    if ((overflowFIFOs & (((uint32_t) 1) << receiveFIFOIndex)) != 0) {
+      mControllerReceiveOverflowCount = mControllerReceiveOverflowCount + 1 ;
+      writeByteRegisterSPI (C1FIFOSTA_REGISTER (receiveFIFOIndex), 0) ; // Clear RXOVIF, other bits are read only
+    }
+    if ((mImmediateReceiveFIFOIndex != receiveFIFOIndex)
+     && ((overflowFIFOs & (((uint32_t) 1) << mImmediateReceiveFIFOIndex)) != 0)) {
+      mControllerReceiveOverflowCount = mControllerReceiveOverflowCount + 1 ;
+      writeByteRegisterSPI (C1FIFOSTA_REGISTER (mImmediateReceiveFIFOIndex), 0) ; // Clear RXOVIF
+    }
+    handled = true ;
+  }
+  if ((intReg & (1 << 12)) != 0) { // SERRIF interrupt
+    writeByteRegisterSPI (C1INT_REGISTER + 1, 1 << 4) ;
+  }
+  mSPI.endTransaction () ;
+  return handled ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517::transmitInterrupt (void) {
+  CANMessage message ;
+  mDriverTransmitBuffer.remove (message) ;
+  mTransmitWatermark.update (mDriverTransmitBuffer.count ()) ;
+  appendInControllerTxFIFO (message) ;
+//--- If driver transmit buffer is empty, disable "FIFO not full" interrupt
+  if (mDriverTransmitBuffer.count () == 0) {
+    uint8_t d = 1 << 7 ;  // FIFO is a transmit FIFO
+    writeByteRegisterSPI (C1FIFOCON_REGISTER (2), d) ;
+    mControllerTxFIFOFull = false ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517::receiveInterrupt (const uint8_t inFIFOIndex) {
+  readByteRegisterSPI (C1FIFOSTA_REGISTER (inFIFOIndex)) ;
+  const uint16_t ramAddress = (uint16_t) (0x400 + readRegisterSPI (C1FIFOUA_REGISTER (inFIFOIndex))) ;
+  ACAN2517RawMessage rawMessage ;
+  assertCS () ;
   #ifndef OPTIMIZED_SPI
     readCommandSPI (ramAddress) ;
-    message.id = readWordSPI () ; //--- Read identifier (see DS20005678B, page 42)
-    const uint32_t data = readWordSPI () ;
-    message.data32 [0] = readWordSPI () ;
-    message.data32 [1] = readWordSPI () ;
+    rawMessage.mIdentifierWord = readWordSPI () ; //--- Read identifier (see DS20005678B, page 42)
+    rawMessage.mControlWord = readWordSPI () ;
+    rawMessage.mData32 [0] = readWordSPI () ;
+    rawMessage.mData32 [1] = readWordSPI () ;
   #else
       const uint16_t readCommand = (ramAddress & 0x0FFF) | (0b0011 << 12) ;
       unsigned char buff[18]={0};
       buff[0] = readCommand >> 8;
       buff[1] = readCommand & 0xFF;
-      message.id  = 0;
-      uint32_t data = 0;
-      message.data64 = 0;
       mSPI.transfer(buff,18);
       // id
-      message.id |= ((uint32_t)buff[2]) << 0;
-      message.id |= ((uint32_t)buff[3]) << 8;
-      message.id |= ((uint32_t)buff[4]) << 16;
-      message.id |= ((uint32_t)buff[5]) << 24;      
+      rawMessage.mIdentifierWord |= ((uint32_t)buff[2]) << 0;
+      rawMessage.mIdentifierWord |= ((uint32_t)buff[3]) << 8;
+      rawMessage.mIdentifierWord |= ((uint32_t)buff[4]) << 16;
+      rawMessage.mIdentifierWord |= ((uint32_t)buff[5]) << 24;
       // data
-      data |= ((uint32_t)buff[6]) << 0;
-      data |= ((uint32_t)buff[7]) << 8;
-      data |= ((uint32_t)buff[8]) << 16;
-      data |= ((uint32_t)buff[9]) << 24;
+      rawMessage.mControlWord |= ((uint32_t)buff[6]) << 0;
+      rawMessage.mControlWord |= ((uint32_t)buff[7]) << 8;
+      rawMessage.mControlWord |= ((uint32_t)buff[8]) << 16;
+      rawMessage.mControlWord |= ((uint32_t)buff[9]) << 24;
       //--- Read data (Swap data if processor is big endian)
       // data32[0]
-      message.data32 [0] |= ((uint32_t)buff[10]) << 0;
-      message.data32 [0] |= ((uint32_t)buff[11]) << 8;
-      message.data32 [0] |= ((uint32_t)buff[12]) << 16;
-      message.data32 [0] |= ((uint32_t)buff[13]) << 24;
+      rawMessage.mData32 [0] |= ((uint32_t)buff[10]) << 0;
+      rawMessage.mData32 [0] |= ((uint32_t)buff[11]) << 8;
+      rawMessage.mData32 [0] |= ((uint32_t)buff[12]) << 16;
+      rawMessage.mData32 [0] |= ((uint32_t)buff[13]) << 24;
       // data32[1]
-      message.data32 [1] |= ((uint32_t)buff[14]) << 0;
-      message.data32 [1] |= ((uint32_t)buff[15]) << 8;
-      message.data32 [1] |= ((uint32_t)buff[16]) << 16;
-      message.data32 [1] |= ((uint32_t)buff[17]) << 24;
+      rawMessage.mData32 [1] |= ((uint32_t)buff[14]) << 0;
+      rawMessage.mData32 [1] |= ((uint32_t)buff[15]) << 8;
+      rawMessage.mData32 [1] |= ((uint32_t)buff[16]) << 16;
+      rawMessage.mData32 [1] |= ((uint32_t)buff[17]) << 24;
   #endif
-  deassertCS () ;  
-    
-  //--- Read DLC, RTR, IDE bits, and math filter index
-    message.rtr = (data & (1 << 5)) != 0 ;
-    message.ext = (data & (1 << 4)) != 0 ;
-    message.len = data & 0x0F ;
-    message.idx = (uint8_t) ((data >> 11) & 0x1F) ;
-
-  //--- If an extended frame is received, identifier bits sould be reordered (see DS20005678B, page 42)
-  if (message.ext) {
-    const uint32_t tempID = message.id ;
-    message.id = ((tempID >> 11) & 0x3FFFF) | ((tempID & 0x7FF) << 18) ;
-  }
-  //--- Append message to driver receive FIFO
-  mDriverReceiveBuffer.append (message) ;
+  deassertCS () ;
+  //--- Filter statistics (filter index and length are read from the message object)
+  if (mFilterStatistics != NULL) {
+    mFilterStatistics->mFrameCount [rawMessage.filterIndex ()] += 1 ;
+    mFilterStatistics->mByteCount [rawMessage.filterIndex ()] += rawMessage.dataLength () ;
+  }
+  //--- Deferred decoding: append message object to driver receive FIFO, if receive pipeline is empty
+  const bool decodingIsDeferred = (mRawReceiveBuffer != NULL)
+    && (mReceiveRing == NULL)
+    && (mReceiveDeadlineMonitor == NULL)
+    && (mDenyList == NULL)
+    && (mContentFilter == NULL)
+    && (mDecimationTable == NULL)
+    && (mChangeOnlyTable == NULL)
+    && (mMailboxTable == NULL)
+    && ((mImmediateFilters & (((uint32_t) 1) << rawMessage.filterIndex ())) == 0)
+    && (rawMessage.filterIndex () < mAdaptiveFirstFilterIndex)
+  ;
+  if (decodingIsDeferred) {
+    if (receiveSinkHasRoom ()) {
+      makeRoomInReceiveSink () ;
+      mRawReceiveBuffer->append (rawMessage) ;
+    }else{
+      mDriverReceiveDropCount = mDriverReceiveDropCount + 1 ;
+    }
+  }else{
+    CANMessage localMessage ;
+    CANMessage & message = (mReceiveRing != NULL) // Decode directly in the user receive ring free slot
+      ? mReceiveRing [*mReceiveRingWriteIndex]
+      : localMessage
+    ;
+    rawMessage.decode (message) ;
+  //--- Re-arm receive deadline
+    if (mReceiveDeadlineMonitor != NULL) {
+      mReceiveDeadlineMonitor->refresh (ACAN2517IdentifierMap::key (message), millis ()) ;
+    }
+  //--- Adaptive filter placement: count hits of frames accepted by the adaptive filters
+    if (message.idx >= mAdaptiveFirstFilterIndex) {
+      mSoftwareDispatchTable->countHit (message) ;
+    }
+  //--- Immediate filter: dispatch message now; otherwise, append it to user receive ring, or to driver receive FIFO
+    if ((mImmediateFilters & (((uint32_t) 1) << message.idx)) != 0) {
+      if (passesReceiveFilters (message) && passesReceiveThrottles (message)) {
+        dispatchToCallBack (message, false) ;
+      }
+    }else if (passesReceiveFilters (message)) {
+    //--- A message with a mailbox does not need room in the receive sink; room is checked before throttles
+      const uint16_t mailbox = (mMailboxTable != NULL) ? mMailboxTable->find (message) : kNoMailbox ;
+      if ((mailbox == kNoMailbox) && !receiveSinkHasRoom ()) {
+        mDriverReceiveDropCount = mDriverReceiveDropCount + 1 ;
+      }else if (passesReceiveThrottles (message)) {
+        if (mailbox != kNoMailbox) {
+          mMailboxTable->store (mailbox, message) ;
+        }else if (mReceiveRing != NULL) {
+          uint32_t nextWriteIndex = *mReceiveRingWriteIndex + 1 ;
+          if (nextWriteIndex == mReceiveRingCapacity) {
+            nextWriteIndex = 0 ;
+          }
+          ACAN2517MemoryBarrier () ; // Message is written before it is published
+          *mReceiveRingWriteIndex = nextWriteIndex ;
+        }else{
+          makeRoomInReceiveSink () ;
+          if (mRawReceiveBuffer != NULL) {
+            mRawReceiveBuffer->append (rawMessage) ;
+          }else{
+            mDriverReceiveBuffer.append (message) ;
+          }
+        }
+      }
+    }
+  }
   //--- Increment FIFO
   const uint8_t d = 1 << 0 ; // Set UINC bit (DS20005688B, page 52)
-  writeByteRegisterSPI (C1FIFOCON_REGISTER (receiveFIFOIndex) + 1, d) ;
-  //--- If driver receive FIFO is full, disable "FIFO not empty" interrupt
-  if (mDriverReceiveBuffer.count () == mDriverReceiveBuffer.size ()) {
-    writeByteRegisterSPI (C1FIFOCON_REGISTER (receiveFIFOIndex), 0) ;
+  writeByteRegisterSPI (C1FIFOCON_REGISTER (inFIFOIndex) + 1, d) ;
+  mReceiveWatermark.update (receiveBufferCount ()) ;
+  //--- Backpressure: if user receive ring or driver receive FIFO is full, disable "FIFO not empty" interrupt
+  if ((mReceiveOverflowPolicy == ACAN2517Settings::Backpressure) && receiveSinkIsFull ()) {
+    writeByteRegisterSPI (C1FIFOCON_REGISTER (receiveFIFOIndex), receiveFIFONotEmptyInterruptDisabled) ;
   }
 }
 
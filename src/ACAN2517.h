@@ -11,7 +11,21 @@
 
 #include <ACAN2517Settings.h>
 #include <ACANBuffer.h>
+#include <ACAN2517RawBuffer.h>
+#include <ACAN2517Watermark.h>
 #include <ACAN2517Filters.h>
+#include <ACAN2517ConstantFilters.h>
+#include <ACAN2517HandlerTable.h>
+#include <ACAN2517FilterCompiler.h>
+#include <ACAN2517DenyList.h>
+#include <ACAN2517ContentFilter.h>
+#include <ACAN2517ChangeOnlyTable.h>
+#include <ACAN2517DecimationTable.h>
+#include <ACAN2517MailboxTable.h>
+#include <ACAN2517EncodedFrame.h>
+#include <ACAN2517PeriodicScheduler.h>
+#include <ACAN2517ReceiveDeadlineMonitor.h>
+#include <ACAN2517SoftwareDispatchTable.h>
 #include <SPI.h>
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
@@ -39,6 +53,26 @@ class ACAN2517 {
                           void (* inInterruptServiceRoutine) (void),
                           const ACAN2517Filters & inFilters) ;
 
+//--- Constant filter table (see ACAN2517ConstantFilters.h): the table is not copied, it should be static
+  public: template <size_t FILTER_COUNT>
+  uint32_t begin (const ACAN2517Settings & inSettings,
+                  void (* inInterruptServiceRoutine) (void),
+                  const ACAN2517ConstantFilter (& inFilters) [FILTER_COUNT]) {
+    static_assert (FILTER_COUNT <= 32, "More than 32 filters") ;
+    return begin (inSettings, inInterruptServiceRoutine, inFilters, (uint8_t) FILTER_COUNT) ;
+  }
+
+  public: uint32_t begin (const ACAN2517Settings & inSettings,
+                          void (* inInterruptServiceRoutine) (void),
+                          const ACAN2517ConstantFilter inFilters [],
+                          const uint8_t inFilterCount) ;
+
+  private: uint32_t beginWithFilters (const ACAN2517Settings & inSettings,
+                                      void (* inInterruptServiceRoutine) (void),
+                                      const ACAN2517Filters * inFilters, // NULL if constant filters are used
+                                      const ACAN2517ConstantFilter inConstantFilters [],
+                                      const uint8_t inConstantFilterCount) ;
+
 //--- Error code returned by begin
   public: static const uint32_t kRequestedConfigurationModeTimeOut  = ((uint32_t) 1) <<  0 ;
   public: static const uint32_t kReadBackErrorWith1MHzSPIClock      = ((uint32_t) 1) <<  1 ;
@@ -60,6 +94,15 @@ class ACAN2517 {
   public: static const uint32_t kX10PLLNotReadyWithin1MS            = ((uint32_t) 1) << 17 ;
   public: static const uint32_t kReadBackErrorWithFullSpeedSPIClock = ((uint32_t) 1) << 18 ;
   public: static const uint32_t kISRNotNullAndNoIntPin              = ((uint32_t) 1) << 19 ;
+  public: static const uint32_t kControllerResidentTransmitFIFOCountGreaterThan29 = ((uint32_t) 1) << 20 ;
+  public: static const uint32_t kControllerResidentTransmitFIFOPriorityGreaterThan31 = ((uint32_t) 1) << 21 ;
+  public: static const uint32_t kPeriodicSchedulerWheelSizeNotPowerOf2 = ((uint32_t) 1) << 22 ;
+  public: static const uint32_t kReceiveDeadlineWheelSizeNotPowerOf2 = ((uint32_t) 1) << 23 ;
+  public: static const uint32_t kPeriodicSchedulerInitializationError = ((uint32_t) 1) << 24 ; // Capacity too large
+  public: static const uint32_t kReceiveDeadlineInitializationError = ((uint32_t) 1) << 25 ; // Capacity too large
+  public: static const uint32_t kFilterIndexGreaterThan31 = ((uint32_t) 1) << 26 ; // Returned by replaceFilter
+  public: static const uint32_t kControllerImmediateReceiveFIFOSizeGreaterThan32 = ((uint32_t) 1) << 27 ;
+  public: static const uint32_t kNoControllerFIFOForImmediateFilters = ((uint32_t) 1) << 28 ; // 29 resident FIFOs
 
 //······················································································································
 //   Send a message
@@ -67,17 +110,422 @@ class ACAN2517 {
 
   public: bool tryToSend (const CANMessage & inMessage) ;
 
+//--- Pre-encoded frame, always sent via the transmit FIFO (no encoding, the object is copied to the SPI buffer)
+  public: bool tryToSend (const ACAN2517EncodedFrame & inFrame) ;
+
+//--- Waits at most inTimeOutMS ms for room in the driver transmit buffer. On ESP32, the calling task sleeps until
+//    the handler task has moved a frame to the controller; elsewhere, it spins calling tryToSend. It returns false
+//    at once if inMessage.idx is neither 0 nor 255, or is 255 while the TXQ is not enabled.
+  public: bool send (const CANMessage & inMessage, const uint32_t inTimeOutMS) ;
+
+//--- true if driver transmit buffer, controller transmit FIFO and TXQ are empty: every message sent before has
+//    been transmitted on the bus (resident transmit FIFOs are not checked)
+  public: bool transmitIsComplete (void) ;
+
+//--- Transmit sequence, for confirming a message sent via the transmit FIFO (inMessage.idx == 0; returns false
+//    otherwise): tryToSend sets outSequence to the sequence number of the message. transmittedSequence returns the
+//    sequence number of the last message that has left the controller transmit FIFO (FIFOCI), and sets outAborted if
+//    a transmission has been aborted since the previous call (TXATIF, retransmission attempts exhausted)
+  public: bool tryToSend (const CANMessage & inMessage, uint32_t & outSequence) ;
+  public: uint32_t transmittedSequence (bool & outAborted) ;
+
+  private: uint32_t mTransmitFIFOSequence = 0 ; // Number of messages written in the controller transmit FIFO
+  private: uint8_t mTransmitFIFOTailIndex = 0 ; // Index of the next message written in the controller transmit FIFO
+  private: uint8_t mControllerTransmitFIFOSize = 1 ;
+  private: void advanceTransmitFIFOSequence (void) ; // Called for every message written in the transmit FIFO
+
+//······················································································································
+//   Controller resident frames (a single message transmit FIFO per frame, FIFO #3, #4, ...)
+//   setResidentFrame writes the whole message object once, triggerResidentFrame sends it again by
+//   a single byte write, updateResidentFrameData rewrites only the changed data words.
+//   All return false if the slot does not exist, or if the frame is still pending.
+//······················································································································
+
+  public: bool setResidentFrame (const uint8_t inSlot, const CANMessage & inMessage) ;
+  public: bool setResidentFrame (const uint8_t inSlot, const ACAN2517EncodedFrame & inFrame) ;
+  public: bool triggerResidentFrame (const uint8_t inSlot) ;
+  public: bool updateResidentFrameData (const uint8_t inSlot, const CANMessage & inMessage) ;
+  public: uint8_t residentFrameCount (void) const { return mResidentFrameCount ; }
+
+//······················································································································
+//   Periodic transmit scheduler (settings.mPeriodicFrameCapacity > 0)
+//   Frames are registered with a period and a phase (in ms); tick sends the due frames via the transmit FIFO.
+//   tick is called by poll, by the ESP32 handler task (every millisecond), or explicitly (date from millis ()).
+//   A deadline is missed when a frame cannot enter the transmit buffer, or when periods are skipped
+//   because tick came too late; the call back is then called from tick, outside the SPI transaction (it can send).
+//   On ESP32, tick runs in the handler task, so this call back and the receive deadline call back run there, with
+//   the constraints of interrupt code: short, no delay or Serial, volatile data shared with loop, and the handler
+//   task stack (settings.mESP32HandlerTaskStackSize).
+//······················································································································
+
+  public: static const uint16_t kNoPeriodicFrame = ACAN2517PeriodicScheduler::kNoPeriodicFrame ;
+  public: static const uint32_t kAutomaticPhase = ACAN2517PeriodicScheduler::kAutomaticPhase ;
+
+  public: uint16_t registerPeriodicFrame (const ACAN2517EncodedFrame & inFrame,
+                                          const uint32_t inPeriodMS,
+                                          const uint32_t inPhaseMS = kAutomaticPhase) ;
+  public: bool cancelPeriodicFrame (const uint16_t inHandle) ;
+  public: bool setPeriodicFrame (const uint16_t inHandle, const ACAN2517EncodedFrame & inFrame) ;
+  public: void tick (const uint32_t inNowMS) ;
+
+  public: typedef void (*tMissedDeadlineCallBack) (const uint16_t inHandle, const uint32_t inMissedCount) ;
+  public: void setMissedDeadlineCallBack (const tMissedDeadlineCallBack inCallBack) { mMissedDeadlineCallBack = inCallBack ; }
+  public: uint32_t periodicFrameMissedDeadlineCount (const uint16_t inHandle) ;
+  public: uint32_t periodicMissedDeadlineCount (void) ;
+
+  private: ACAN2517PeriodicScheduler * mPeriodicScheduler = NULL ;
+  private: tMissedDeadlineCallBack mMissedDeadlineCallBack = NULL ;
+
+//······················································································································
+//   Receive deadline monitor (settings.mReceiveDeadlineCapacity > 0)
+//   Every reception of a monitored identifier re-arms its deadline; tick flags the identifiers that were not
+//   received within their time out (in ms), and calls the call back. A flag is cleared by the next reception.
+//   On ESP32, the call back runs in the handler task (see periodic transmit scheduler above).
+//······················································································································
+
+  public: static const uint16_t kNoMonitoredFrame = ACAN2517ReceiveDeadlineMonitor::kNoMonitoredFrame ;
+
+  public: uint16_t monitorReceiveDeadline (const tFrameFormat inFormat,
+                                           const uint32_t inIdentifier,
+                                           const uint32_t inTimeOutMS) ;
+
+  public: typedef void (*tReceiveDeadlineCallBack) (const uint16_t inIndex) ;
+  public: void setReceiveDeadlineCallBack (const tReceiveDeadlineCallBack inCallBack) { mReceiveDeadlineCallBack = inCallBack ; }
+  public: bool receiveDeadlineExpired (const uint16_t inIndex) ;
+  public: uint32_t receiveDeadlineExpiredFlags (const uint16_t inWordIndex) ; // Indexes 32 * inWordIndex ...
+  public: uint32_t receiveDeadlineExpirationCount (void) ;
+
+  private: ACAN2517ReceiveDeadlineMonitor * mReceiveDeadlineMonitor = NULL ;
+  private: tReceiveDeadlineCallBack mReceiveDeadlineCallBack = NULL ;
+
 //······················································································································
 //    Receive a message
 //······················································································································
 
   public: bool receive (CANMessage & outMessage) ;
   public: bool available (void) ;
+
+//--- Waits at most inTimeOutMS ms for a message. On ESP32, the calling task sleeps until the handler task has
+//    received a message; elsewhere, it spins calling receive.
+  public: bool receive (CANMessage & outMessage, const uint32_t inTimeOutMS) ;
   public: typedef void (*tFilterMatchCallBack) (const uint32_t inFilterIndex) ;
   public: bool dispatchReceivedMessage (const tFilterMatchCallBack inFilterMatchCallBack = NULL) ;
 
-//--- Call back function array
+//--- In place access to the driver receive buffer: peek returns the oldest message (NULL if none),
+//    peekContiguous returns the number of messages stored contiguously from it (0 if none); they remain valid
+//    until consume removes them (consume returns the removed count). dispatchReceivedMessage removes a message
+//    with a single lock, then dispatches its copy; dispatchAll dispatches messages in place, so its call back
+//    routines should not call receive, consume or dispatchReceivedMessage.
+  public: const CANMessage * peek (void) ;
+  public: uint32_t peekContiguous (const CANMessage * & outFirstMessage) ;
+  public: uint32_t consume (const uint32_t inCount = 1) ;
+
+//--- Called within the receive lock
+  private: uint32_t peekContiguousWithinLock (const CANMessage * & outFirstMessage) ;
+  private: uint32_t consumeWithinLock (const uint32_t inCount) ;
+
+//--- Batch reception: receiveBatch takes the lock once, and moves up to inMaxCount messages to outMessages.
+//    dispatchAll dispatches messages in place, taking the lock once per contiguous span (a span is consumed
+//    with the peek of the next one), and stops after inMaxCount messages, or when inMaxMicros µs have elapsed
+//    (0 --> no time budget). With deferred decoding, a span is one message: receiveBatch is the batch path.
+//    Both return the message count.
+  public: uint32_t receiveBatch (CANMessage outMessages [], const uint32_t inMaxCount) ;
+  public: uint32_t dispatchAll (const uint32_t inMaxCount, const uint32_t inMaxMicros = 0) ;
+
+//--- Handler table dispatch (see ACAN2517HandlerTable.h): handler calls can be inlined; a message accepted
+//    by a filter without handler goes to the call back routine of the filter
+  public: template <typename... HANDLERS> bool dispatchReceivedMessage (ACAN2517HandlerTable <HANDLERS...> & ioTable) {
+    CANMessage receivedMessage ;
+    const bool hasReceived = receive (receivedMessage) ; // Single lock
+    if (hasReceived && !ioTable.handle (receivedMessage.idx, receivedMessage)) {
+      dispatchToCallBack (receivedMessage) ;
+    }
+    return hasReceived ;
+  }
+
+//--- Call back routine with a user context, for a filter (0 ... 31); it has precedence over the call back
+//    routine given by the filter definition. A NULL routine removes it; begin removes all of them.
+  public: typedef void (*tCallBackRoutineWithContext) (const CANMessage & inMessage, void * inContext) ;
+  public: bool setFilterCallBack (const uint8_t inFilterIndex,
+                                  const tCallBackRoutineWithContext inCallBackRoutine,
+                                  void * inContext) ;
+
+  private: class CallBackWithContext {
+    public: tCallBackRoutineWithContext mCallBackRoutine = NULL ;
+    public: void * mContext = NULL ;
+  } ;
+
+  private: CallBackWithContext mCallBackWithContextArray [32] ; // Cleared by begin
+
+  private: void dispatchToCallBack (const CANMessage & inMessage, const bool inUsesSoftwareDispatchTable = true) ;
+
+//······················································································································
+//    Immediate filters (0 ... 31): a message accepted by an immediate filter is dispatched by receiveInterrupt
+//    (on ESP32, by the handler task) right after decoding, instead of entering the driver receive buffer. It
+//    still goes through the receive pipeline (deny list, content filter, decimation, change only), but not through
+//    mailboxes or the user receive ring. Only the filter call back is called (setFilterCallBack, or filter
+//    definition), not the software dispatch table. The call back runs in interrupt context, with the SPI
+//    transaction open: it should be short, it should not call the driver, delay or Serial, and data shared with
+//    loop should be volatile. On ESP32, it runs on the handler task stack (settings.mESP32HandlerTaskStackSize,
+//    4096 bytes by default): large local variables and deep calls need a larger stack. begin clears all immediate
+//    flags.
+//    With settings.mControllerImmediateReceiveFIFOSize > 0, an immediate filter stores its messages in its own
+//    controller receive FIFO, that the interrupt service routine serves even while the receive sink is full
+//    (backpressure). Otherwise, immediate messages wait in the receive FIFO behind the other messages.
+//······················································································································
+
+  public: bool setImmediateFilter (const uint8_t inFilterIndex, const bool inImmediate) ;
+
+  private: uint8_t filterControl (const uint8_t inFilterIndex) const ; // C1FLTCON byte of an enabled filter
+
+  private: volatile uint32_t mImmediateFilters = 0 ; // Bit i: filter i is immediate
+  private: uint8_t mImmediateReceiveFIFOIndex = 1 ; // Controller FIFO of immediate filters, 1 if none
+
+//······················································································································
+//    Filter statistics (settings.mFilterStatistics is true): frames and data bytes received by every
+//    hardware filter, counted by the interrupt service routine. Return false if statistics are not enabled.
+//······················································································································
+
+  public: class FilterStatistics {
+    public: uint32_t mFrameCount [32] ;
+    public: uint32_t mByteCount [32] ;
+  } ;
+
+  public: bool getFilterStatistics (FilterStatistics & outStatistics, const bool inReset = false) ;
+  public: bool resetFilterStatistics (void) ;
+
+  private: FilterStatistics * mFilterStatistics = NULL ;
+
+//······················································································································
+//    Deny list (settings.mStandardDenyList, settings.mExtendedDenyListCapacity): frames accepted by the
+//    hardware filters but denied are dropped before entering the driver receive buffer. Return false if the
+//    deny list is not enabled for this format, if identifier is too large, or if there is no room left.
+//······················································································································
+
+  public: bool denyFrame (const tFrameFormat inFormat, const uint32_t inIdentifier) ;
+  public: bool allowFrame (const tFrameFormat inFormat, const uint32_t inIdentifier) ;
+  public: uint32_t deniedFrameCount (void) ;
+
+  private: ACAN2517DenyList * mDenyList = NULL ;
+  private: uint32_t mDeniedFrameCount = 0 ;
+
+//······················································································································
+//    Content filter (settings.mContentFilterCapacity > 0): a frame whose identifier matches the mask / acceptance
+//    of at least one rule is kept only if (data64 & inDataMask) == inDataValue for one of these rules.
+//    Returns false if there is no room left, or if mask or acceptance is too large.
+//······················································································································
+
+  public: bool appendContentFilter (const tFrameFormat inFormat,
+                                    const uint32_t inIdentifierMask,
+                                    const uint32_t inIdentifierAcceptance,
+                                    const uint64_t inDataMask,
+                                    const uint64_t inDataValue) ;
+  public: uint32_t contentRejectedFrameCount (void) ;
+
+  private: ACAN2517ContentFilter * mContentFilter = NULL ;
+  private: uint32_t mContentRejectedFrameCount = 0 ;
+
+//······················································································································
+//    Change only delivery (settings.mChangeOnlyCapacity > 0): a frame of a registered identifier with the same
+//    length and data as the last delivered one is dropped, unless inRefreshIntervalMS (0: never) has elapsed.
+//    Returns false if there is no room left, or if identifier is too large.
+//······················································································································
+
+  public: bool deliverOnChange (const tFrameFormat inFormat,
+                                const uint32_t inIdentifier,
+                                const uint32_t inRefreshIntervalMS = 0) ;
+  public: uint32_t unchangedFrameCount (void) ;
+
+  private: ACAN2517ChangeOnlyTable * mChangeOnlyTable = NULL ;
+  private: uint32_t mUnchangedFrameCount = 0 ;
+
+//······················································································································
+//    Receive decimation (settings.mDecimationCapacity > 0): for a registered identifier, keep one frame out of
+//    inRatio, or at most one frame every inMinIntervalUS µs. Return false if there is no room left, or if
+//    identifier is too large.
+//······················································································································
+
+  public: bool decimateFrame (const tFrameFormat inFormat,
+                              const uint32_t inIdentifier,
+                              const uint16_t inRatio) ;
+  public: bool limitFrameRate (const tFrameFormat inFormat,
+                               const uint32_t inIdentifier,
+                               const uint32_t inMinIntervalUS) ;
+  public: uint32_t decimatedFrameCount (void) ;
+
+  private: ACAN2517DecimationTable * mDecimationTable = NULL ;
+  private: uint32_t mDecimatedFrameCount = 0 ;
+
+//······················································································································
+//    Mailboxes (settings.mMailboxCapacity > 0): the latest accepted frame of a registered identifier is written in
+//    its mailbox, it does not enter the driver receive buffer. readMailbox does not lock, it returns false if
+//    no frame has been received yet; outSequence changes with every update (2 * update count).
+//······················································································································
+
+  public: static const uint16_t kNoMailbox = ACAN2517MailboxTable::kNoMailbox ;
+
+  public: uint16_t registerMailbox (const tFrameFormat inFormat, const uint32_t inIdentifier) ;
+  public: bool readMailbox (const uint16_t inMailbox, CANMessage & outMessage, uint32_t & outSequence) const ;
+
+  private: ACAN2517MailboxTable * mMailboxTable = NULL ;
+
+//······················································································································
+//    User receive ring: accepted messages are decoded by receiveInterrupt directly in inStorage [*ioWriteIndex],
+//    instead of the driver receive buffer. The driver only writes *ioWriteIndex, the application only writes
+//    *ioReadIndex; the ring is empty when both are equal, so it holds inCapacity - 1 messages. When it is full,
+//    messages are left in the controller receive FIFO: call notifyReceiveRingConsumed after advancing *ioReadIndex.
+//    setReceiveRing (NULL, 0, NULL, NULL) restores the driver receive buffer. Returns false if arguments are invalid.
+//······················································································································
+
+  public: bool setReceiveRing (CANMessage inStorage [],
+                               const uint32_t inCapacity,
+                               volatile uint32_t * ioWriteIndex,
+                               volatile uint32_t * ioReadIndex) ;
+  public: void notifyReceiveRingConsumed (void) ;
+
+  private: CANMessage * mReceiveRing = NULL ;
+  private: uint32_t mReceiveRingCapacity = 0 ;
+  private: volatile uint32_t * mReceiveRingWriteIndex = NULL ;
+  private: volatile uint32_t * mReceiveRingReadIndex = NULL ;
+
+//--- true if the user receive ring (or the driver receive buffer, if there is no user ring) is full
+  private: bool receiveSinkIsFull (void) const ;
+
+//······················································································································
+//    Receive overflow: driverReceiveDropCount counts the messages dropped by the driver (settings.
+//    mDriverReceiveOverflowPolicy is DropOldest or DropNewest), controllerReceiveOverflowCount counts the
+//    controller receive FIFO and immediate receive FIFO overflows (RXOVIF, at least one message lost each). Both
+//    are read without locking.
+//······················································································································
+
+  public: uint32_t driverReceiveDropCount (void) const { return mDriverReceiveDropCount ; }
+  public: uint32_t controllerReceiveOverflowCount (void) const { return mControllerReceiveOverflowCount ; }
+
+  private: ACAN2517Settings::ReceiveOverflowPolicy mReceiveOverflowPolicy = ACAN2517Settings::Backpressure ;
+  private: volatile uint32_t mDriverReceiveDropCount = 0 ;
+  private: volatile uint32_t mControllerReceiveOverflowCount = 0 ;
+
+//--- Called by receiveInterrupt: receiveSinkHasRoom returns false if the message should be dropped (checked
+//    before the stateful stages of the receive pipeline); makeRoomInReceiveSink then drops the oldest message
+//    if the sink is full (DropOldest)
+  private: bool receiveSinkHasRoom (void) const ;
+  private: void makeRoomInReceiveSink (void) ;
+
+//--- Messages dropped by DropOldest since the last peek: consume does not remove them again
+  private: uint32_t mDroppedOldestCount = 0 ;
+
+//······················································································································
+//    Watermarks: the call back is called with true when the driver receive (or transmit) buffer count reaches
+//    inHighWatermark, and with false when it then falls to inLowWatermark (inCallBack == NULL --> disabled).
+//    It is called where the crossing occurs: receive high and transmit low crossings by the interrupt service
+//    routine, others by the function that removes or appends messages (receive, receiveBatch, consume,
+//    dispatchReceivedMessage, dispatchAll, tryToSend); it should not call the driver.
+//    Messages written in a user receive ring are not counted.
+//······················································································································
+
+  public: typedef ACAN2517Watermark::tCallBack tWatermarkCallBack ;
+
+  public: void setReceiveWatermarks (const uint32_t inHighWatermark,
+                                     const uint32_t inLowWatermark,
+                                     const tWatermarkCallBack inCallBack) ;
+  public: void setTransmitWatermarks (const uint32_t inHighWatermark,
+                                      const uint32_t inLowWatermark,
+                                      const tWatermarkCallBack inCallBack) ;
+
+  private: ACAN2517Watermark mReceiveWatermark ;
+  private: ACAN2517Watermark mTransmitWatermark ;
+
+//--- Driver receive buffer count (raw receive buffer count if decoding is deferred)
+  private: uint32_t receiveBufferCount (void) const ;
+
+//--- Receive pipeline: return false if the message should be dropped by receiveInterrupt. Filters (deny list,
+//    content filter) have no state; throttles (decimation, change only) update their state, so they are called
+//    only when the message can be delivered
+  private: bool passesReceiveFilters (const CANMessage & inMessage) ;
+  private: bool passesReceiveThrottles (const CANMessage & inMessage) ;
+
+//--- Call back function array (32 entries, one per hardware filter); NULL if constant filters are used, until
+//    replaceFilter is called
   private: ACANCallBackRoutine * mCallBackFunctionArray = NULL ;
+  private: const ACAN2517ConstantFilter * mConstantFilterTable = NULL ;
+  private: uint8_t mConstantFilterCount = 0 ;
+
+//······················································································································
+//    Runtime filter update, after begin (filter index: 0 ... 31)
+//    A filter is disabled (C1FLTCON FLTEN = 0) while its mask and acceptance are written, the controller keeps
+//    receiving with the other filters. Messages already in the driver receive buffer are dispatched to the
+//    new call back routine. replaceFilter returns 0, or kFilterIndexGreaterThan31 and / or kFilterDefinitionError.
+//    enableFilter returns false for a filter that has not been programmed by begin or replaceFilter.
+//······················································································································
+
+  public: uint32_t replaceFilter (const uint8_t inFilterIndex,
+                                  const tFrameFormat inFormat,
+                                  const uint32_t inMask,
+                                  const uint32_t inAcceptance,
+                                  const ACANCallBackRoutine inCallBackRoutine) ;
+  public: uint32_t replaceFrameFilter (const uint8_t inFilterIndex,
+                                       const tFrameFormat inFormat,
+                                       const uint32_t inIdentifier,
+                                       const ACANCallBackRoutine inCallBackRoutine) ;
+  public: bool enableFilter (const uint8_t inFilterIndex) ;
+  public: bool disableFilter (const uint8_t inFilterIndex) ;
+
+  private: uint32_t mConfiguredFilters = 0 ; // Bit i: filter i has been programmed
+
+//--- Software dispatch table: dispatchReceivedMessage uses it for frames accepted by a hardware filter
+//    whose call back routine is NULL (for example, a pass all filter). Entries are appended after begin,
+//    up to the settings capacities; returns false if there is no room left, or if identifier is too large.
+  public: bool appendSoftwareFrameFilter (const tFrameFormat inFormat,
+                                          const uint32_t inIdentifier,
+                                          const ACANCallBackRoutine inCallBackRoutine) ;
+  public: bool appendSoftwareFilter (const tFrameFormat inFormat,
+                                     const uint32_t inMask,
+                                     const uint32_t inAcceptance,
+                                     const ACANCallBackRoutine inCallBackRoutine) ;
+
+  private: ACAN2517SoftwareDispatchTable * mSoftwareDispatchTable = NULL ;
+
+//··· Frames dispatched by the software table without any matching entry (unwanted frames read over SPI)
+  public: uint32_t softwareRejectedFrameCount (void) const ;
+
+//······················································································································
+//    Adaptive filter placement (requires the software dispatch table)
+//    Hardware filters inFirstFilterIndex ... 31 are handed over to the exact identifiers of the software table:
+//    the inHotFilterCount most received identifiers get an exact filter each, the other ones are covered by the
+//    remaining filters, as mask / acceptance pairs computed by ACAN2517FilterCompiler (at least 2 filters are
+//    left for them). Hits are counted by receiveInterrupt for frames accepted by these filters, whatever the
+//    reception API. Placement is recomputed by rebalanceFilters, only changed filters are rewritten; hit counts
+//    are then halved. Compiling is O(n^3) in the identifier count, so it is never called by tick or poll: call
+//    updateFilterPlacement from loop, it calls rebalanceFilters every inPeriodMS (0: only explicit calls).
+//    Identifiers appended later are placed by the next call.
+//······················································································································
+
+  public: bool setAdaptiveFilterPlacement (const uint8_t inFirstFilterIndex,
+                                           const uint8_t inHotFilterCount,
+                                           const uint32_t inPeriodMS) ;
+  public: bool rebalanceFilters (void) ;
+  public: bool updateFilterPlacement (void) ; // Returns true if filters have been rebalanced
+
+  private: class AdaptiveFilter { // Filter as last written by rebalanceFilters
+    public: uint32_t mMask = 0 ;
+    public: uint32_t mAcceptance = 0 ;
+    public: bool mExtended = false ;
+    public: bool mEnabled = false ;
+    public: bool mWritten = false ; // false --> filter has not been written yet
+  } ;
+
+  private: void placeAdaptiveFilter (const uint8_t inFilterIndex,
+                                     const tFrameFormat inFormat,
+                                     const uint32_t inMask,
+                                     const uint32_t inAcceptance) ;
+
+  private: ACAN2517FilterCompiler * mAdaptiveFilterCompiler = NULL ;
+  private: uint16_t * mAdaptiveHotIndexes = NULL ; // Software table indexes, by decreasing hit count
+  private: AdaptiveFilter * mAdaptiveFilters = NULL ; // Filters inFirstFilterIndex ... 31
+  private: uint32_t mAdaptivePeriodMS = 0 ;
+  private: uint32_t mAdaptiveRebalanceDate = 0 ;
+  private: uint8_t mAdaptiveFirstFilterIndex = 32 ;
+  private: uint8_t mAdaptiveHotFilterCount = 0 ;
 
 //······················································································································
 //    Get error counters
@@ -96,11 +544,25 @@ class ACAN2517 {
   private: bool mUsesTXQ ;
   private: bool mControllerTxFIFOFull ;
 
+//······················································································································
+//    Resident frames
+//······················································································································
+
+  private: class ResidentFrame {
+    public: uint16_t mRamAddress = 0 ; // 0 --> frame not loaded
+    public: uint32_t mData32 [2] = {0, 0} ; // Data words actually in controller RAM
+  } ;
+
+  private: ResidentFrame * mResidentFrameArray = NULL ;
+  private: uint8_t mResidentFrameCount = 0 ;
+
 //······················································································································
 //    Receive buffer
 //······················································································································
 
   private: ACANBuffer mDriverReceiveBuffer ;
+  private: ACAN2517RawBuffer * mRawReceiveBuffer = NULL ; // Deferred decoding: replaces mDriverReceiveBuffer
+  private: CANMessage mPeekedMessage ; // Deferred decoding or DropOldest: copy of head, returned by peek
 
 //······················································································································
 //    Transmit buffer
@@ -139,6 +601,11 @@ class ACAN2517 {
   public: bool sendViaTXQ (const CANMessage & inMessage) ;
   public: bool enterInTransmitBuffer (const CANMessage & inMessage) ;
   public: void appendInControllerTxFIFO (const CANMessage & inMessage) ;
+  public: bool enterInTransmitBuffer (const ACAN2517EncodedFrame & inFrame) ;
+  public: void appendInControllerTxFIFO (const ACAN2517EncodedFrame & inFrame) ;
+  public: void checkControllerTxFIFOFull (void) ;
+  public: void writeEncodedFrameSPI (const uint16_t inRamAddress, const ACAN2517EncodedFrame & inFrame) ;
+  public: bool residentFrameIsPending (const uint8_t inSlot) ;
 
 //······················································································································
 //    Polling
@@ -152,10 +619,19 @@ class ACAN2517 {
 
   public: void isr (void) ;
   public: bool isr_core (void) ;
-  private: void receiveInterrupt (void) ;
+  private: void receiveInterrupt (const uint8_t inFIFOIndex) ;
+  private: void enterReceiveLock (void) ;
+  private: void leaveReceiveLock (void) ;
+  private: void enterTransmitLock (void) ;
+  private: void leaveTransmitLock (void) ;
   private: void transmitInterrupt (void) ;
   #ifdef ARDUINO_ARCH_ESP32
     public: SemaphoreHandle_t mISRSemaphore ;
+    private: SemaphoreHandle_t mReceiveSemaphore ; // Given by isr_core after a reception, for receive with time out
+    private: SemaphoreHandle_t mTransmitSemaphore ; // Given by isr_core after a transmission, for send
+    public: bool needsTick (void) const {
+      return (mPeriodicScheduler != NULL) || (mReceiveDeadlineMonitor != NULL) ;
+    }
   #endif
 
 //······················································································································
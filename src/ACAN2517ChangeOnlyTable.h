@@ -0,0 +1,125 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Change only table, checked by receiveInterrupt: for every registered identifier, the last delivered payload is
+// kept; a frame with the same length, kind and data is a repeat, and is dropped, unless the refresh interval has
+// elapsed since the last delivery. Storage is allocated once, by initWithSize.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_CHANGE_ONLY_TABLE_CLASS_DEFINED
+#define ACAN2517_CHANGE_ONLY_TABLE_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517IdentifierMap.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517ChangeOnlyTable class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517ChangeOnlyTable {
+
+//······················································································································
+//   EMBEDDED CLASS
+//······················································································································
+
+  private: class Entry {
+    public: uint64_t mData64 = 0 ; // Bytes beyond length are zero
+    public: uint32_t mRefreshInterval = 0 ; // 0 --> no forced refresh
+    public: uint32_t mDeliveryDate = 0 ;
+    public: uint8_t mLength = 0 ;
+    public: bool mRemote = false ;
+    public: bool mValid = false ; // false until first delivery
+  } ;
+
+//······················································································································
+//   CONSTRUCTOR
+//······················································································································
+
+  public: ACAN2517ChangeOnlyTable (void) {}
+
+//······················································································································
+//   DESTRUCTOR
+//······················································································································
+
+  public: ~ ACAN2517ChangeOnlyTable (void) {
+    delete [] mEntries ;
+  }
+
+//······················································································································
+//   INIT
+//······················································································································
+
+  public: void initWithSize (const uint16_t inCapacity) {
+    mMap.initWithCapacity (inCapacity) ;
+    mEntries = new Entry [inCapacity] ;
+  }
+
+//······················································································································
+//   ADD AN IDENTIFIER (returns false if there is no room left)
+//······················································································································
+
+  public: bool add (const uint32_t inKey, const uint32_t inRefreshInterval) {
+    const uint16_t index = mMap.slot (inKey) ;
+    const bool ok = index != ACAN2517IdentifierMap::kNone ;
+    if (ok) {
+      mEntries [index] = Entry () ;
+      mEntries [index].mRefreshInterval = inRefreshInterval ;
+    }
+    return ok ;
+  }
+
+//······················································································································
+//   REPEAT CHECK (a delivered frame becomes the reference)
+//······················································································································
+
+  public: inline bool isRepeat (const CANMessage & inMessage, const uint32_t inNow) {
+    const uint16_t index = mMap.find (ACAN2517IdentifierMap::key (inMessage)) ;
+    bool repeat = false ;
+    if (index != ACAN2517IdentifierMap::kNone) {
+      Entry & entry = mEntries [index] ;
+      const uint8_t length = (inMessage.len > 8) ? 8 : inMessage.len ;
+      const uint64_t data64 = (inMessage.rtr || (length == 0))
+        ? 0
+        : (inMessage.data64 & (~ (uint64_t) 0 >> (64 - 8 * length)))
+      ;
+      repeat = entry.mValid
+        && (entry.mLength == length)
+        && (entry.mRemote == inMessage.rtr)
+        && (entry.mData64 == data64)
+        && ((entry.mRefreshInterval == 0) || ((inNow - entry.mDeliveryDate) < entry.mRefreshInterval))
+      ;
+      if (!repeat) {
+        entry.mData64 = data64 ;
+        entry.mLength = length ;
+        entry.mRemote = inMessage.rtr ;
+        entry.mDeliveryDate = inNow ;
+        entry.mValid = true ;
+      }
+    }
+    return repeat ;
+  }
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+  private: ACAN2517IdentifierMap mMap ; // Identifier -> index in mEntries
+  private: Entry * mEntries = NULL ;
+
+//······················································································································
+//   NO COPY
+//······················································································································
+
+  private: ACAN2517ChangeOnlyTable (const ACAN2517ChangeOnlyTable &) = delete ;
+  private: ACAN2517ChangeOnlyTable & operator = (const ACAN2517ChangeOnlyTable &) = delete ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
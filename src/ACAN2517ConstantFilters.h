@@ -0,0 +1,152 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Constant filter: a C1MASK / C1FLTOBJ / call back routine triple computed at compile time. A constexpr array
+// of constant filters replaces an ACAN2517Filters object for a fixed configuration: no heap allocation, and the
+// table is in flash on ARM and ESP32 targets (on AVR, constant data is copied in RAM at startup).
+//
+//   static constexpr ACAN2517ConstantFilter filters [] = {
+//     ACAN2517ConstantFilter::frameFilter (kStandard, 0x123, receiveFromFilter0),
+//     ACAN2517ConstantFilter::filter (kStandard, 0x70F, 0x304, receiveFromFilter1)
+//   } ;
+//   static_assert (ACAN2517ConstantFilter::isValidTable (filters), "Invalid filter") ;
+//   ...
+//   const uint32_t errorCode = can.begin (settings, [] { can.isr () ; }, filters) ;
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_CONSTANT_FILTERS_CLASS_DEFINED
+#define ACAN2517_CONSTANT_FILTERS_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517Filters.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517ConstantFilter class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517ConstantFilter {
+
+//······················································································································
+//   FACTORIES (same semantics as ACAN2517Filters append methods)
+//······················································································································
+
+  public: static constexpr ACAN2517ConstantFilter passAllFilter (const ACANCallBackRoutine inCallBackRoutine) {
+    return ACAN2517ConstantFilter (0, 0, inCallBackRoutine, ACAN2517Filters::kFiltersOk) ;
+  }
+
+//······················································································································
+
+  public: static constexpr ACAN2517ConstantFilter formatFilter (const tFrameFormat inFormat,
+                                                                const ACANCallBackRoutine inCallBackRoutine) {
+    return ACAN2517ConstantFilter (((uint32_t) 1) << 30,
+                                   (inFormat == kExtended) ? (((uint32_t) 1) << 30) : 0,
+                                   inCallBackRoutine,
+                                   ACAN2517Filters::kFiltersOk) ;
+  }
+
+//······················································································································
+
+  public: static constexpr ACAN2517ConstantFilter frameFilter (const tFrameFormat inFormat,
+                                                               const uint32_t inIdentifier,
+                                                               const ACANCallBackRoutine inCallBackRoutine) {
+    return (inIdentifier > identifierMask (inFormat))
+      ? ACAN2517ConstantFilter (0, 0, inCallBackRoutine, (inFormat == kExtended)
+          ? ACAN2517Filters::kExtendedIdentifierTooLarge
+          : ACAN2517Filters::kStandardIdentifierTooLarge)
+      : filter (inFormat, identifierMask (inFormat), inIdentifier, inCallBackRoutine)
+    ;
+  }
+
+//······················································································································
+
+  public: static constexpr ACAN2517ConstantFilter filter (const tFrameFormat inFormat,
+                                                          const uint32_t inMask,
+                                                          const uint32_t inAcceptance,
+                                                          const ACANCallBackRoutine inCallBackRoutine) {
+    return ACAN2517ConstantFilter ((((uint32_t) 1) << 30) | reorder (inFormat, inMask),
+                                   reorder (inFormat, inAcceptance)
+                                     | ((inFormat == kExtended) ? (((uint32_t) 1) << 30) : 0),
+                                   inCallBackRoutine,
+                                   status (inFormat, inMask, inAcceptance)) ;
+  }
+
+//······················································································································
+//   TABLE VALIDATION (for static_assert)
+//······················································································································
+
+  public: template <size_t FILTER_COUNT>
+  static constexpr bool isValidTable (const ACAN2517ConstantFilter (& inTable) [FILTER_COUNT],
+                                      const size_t inIndex = 0) {
+    return (FILTER_COUNT <= 32)
+      && ((inIndex >= FILTER_COUNT)
+        || ((inTable [inIndex].mFilterStatus == ACAN2517Filters::kFiltersOk) && isValidTable (inTable, inIndex + 1)))
+    ;
+  }
+
+//······················································································································
+//   PROPERTIES
+//······················································································································
+
+  public: const uint32_t mFilterMask ; // C1MASK value
+  public: const uint32_t mAcceptanceFilter ; // C1FLTOBJ value
+  public: const ACANCallBackRoutine mCallBackRoutine ;
+  public: const ACAN2517Filters::FilterStatus mFilterStatus ;
+
+//······················································································································
+//   PRIVATE CONSTRUCTOR
+//······················································································································
+
+  private: constexpr ACAN2517ConstantFilter (const uint32_t inFilterMask,
+                                             const uint32_t inAcceptanceFilter,
+                                             const ACANCallBackRoutine inCallBackRoutine,
+                                             const ACAN2517Filters::FilterStatus inFilterStatus) :
+  mFilterMask (inFilterMask),
+  mAcceptanceFilter (inAcceptanceFilter),
+  mCallBackRoutine (inCallBackRoutine),
+  mFilterStatus (inFilterStatus) {
+  }
+
+//······················································································································
+//   PRIVATE METHODS
+//······················································································································
+
+  private: static constexpr uint32_t identifierMask (const tFrameFormat inFormat) {
+    return (inFormat == kExtended) ? 0x1FFFFFFF : 0x7FF ;
+  }
+
+//--- Bits are re ordered for an extended identifier (SID in bits 0-10, EID in bits 11-28)
+  private: static constexpr uint32_t reorder (const tFrameFormat inFormat, const uint32_t inValue) {
+    return (inFormat == kExtended)
+      ? (((inValue >> 18) & 0x7FF) | ((inValue & 0x3FFFF) << 11))
+      : inValue
+    ;
+  }
+
+//--- Same checks as ACAN2517Filters::appendFilter (mask error has precedence)
+  private: static constexpr ACAN2517Filters::FilterStatus status (const tFrameFormat inFormat,
+                                                                  const uint32_t inMask,
+                                                                  const uint32_t inAcceptance) {
+    return (inMask > identifierMask (inFormat))
+      ? ((inFormat == kExtended) ? ACAN2517Filters::kExtendedMaskTooLarge : ACAN2517Filters::kStandardMaskTooLarge)
+      : (inAcceptance > identifierMask (inFormat))
+        ? ((inFormat == kExtended)
+          ? ACAN2517Filters::kExtendedAcceptanceTooLarge
+          : ACAN2517Filters::kStandardAcceptanceTooLarge)
+        : ((inMask & inAcceptance) != inAcceptance)
+          ? ACAN2517Filters::kInconsistencyBetweenMaskAndAcceptance
+          : ACAN2517Filters::kFiltersOk
+    ;
+  }
+
+//······················································································································
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
@@ -0,0 +1,129 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Content filter, checked by receiveInterrupt: a rule is an identifier mask / acceptance pair and a 64-bit data
+// mask / value pair. A frame whose identifier matches at least one rule is accepted only if its data matches one of
+// these rules; a frame whose identifier matches no rule is accepted. Every rule is evaluated by two masked
+// compares and a length compare: the minimum length is computed from the data mask when the rule is appended.
+// Data byte i is bits 8*i ... 8*i+7 of data64 (little endian targets).
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_CONTENT_FILTER_CLASS_DEFINED
+#define ACAN2517_CONTENT_FILTER_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517IdentifierMap.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517ContentFilter class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517ContentFilter {
+
+//······················································································································
+//   EMBEDDED CLASS
+//······················································································································
+
+  private: class Rule {
+    public: uint64_t mDataMask = 0 ;
+    public: uint64_t mDataValue = 0 ;
+    public: uint32_t mIdentifierMask = 0 ; // Identifier map keys
+    public: uint32_t mIdentifierValue = 0 ;
+    public: uint8_t mMinLength = 0 ;
+  } ;
+
+//······················································································································
+//   CONSTRUCTOR
+//······················································································································
+
+  public: ACAN2517ContentFilter (void) {}
+
+//······················································································································
+//   DESTRUCTOR
+//······················································································································
+
+  public: ~ ACAN2517ContentFilter (void) {
+    delete [] mRules ;
+  }
+
+//······················································································································
+//   INIT
+//······················································································································
+
+  public: void initWithSize (const uint8_t inCapacity) {
+    mRules = new Rule [inCapacity] ;
+    mCapacity = inCapacity ;
+  }
+
+//······················································································································
+//   APPEND (returns false if there is no room left)
+//······················································································································
+
+  public: bool append (const uint32_t inIdentifierMask,
+                       const uint32_t inIdentifierValue,
+                       const uint64_t inDataMask,
+                       const uint64_t inDataValue) {
+    const bool ok = mCount < mCapacity ;
+    if (ok) {
+      Rule & rule = mRules [mCount] ;
+      rule.mIdentifierMask = inIdentifierMask ;
+      rule.mIdentifierValue = inIdentifierValue & inIdentifierMask ;
+      rule.mDataMask = inDataMask ;
+      rule.mDataValue = inDataValue & inDataMask ;
+      uint8_t minLength = 0 ;
+      for (uint8_t i = 0 ; i < 8 ; i++) {
+        if (((inDataMask >> (8 * i)) & 0xFF) != 0) {
+          minLength = i + 1 ;
+        }
+      }
+      rule.mMinLength = minLength ;
+      mCount += 1 ;
+    }
+    return ok ;
+  }
+
+//······················································································································
+//   EVALUATION
+//······················································································································
+
+  public: inline bool accepts (const CANMessage & inMessage) const {
+    const uint32_t key = ACAN2517IdentifierMap::key (inMessage) ;
+    bool identifierMatches = false ;
+    bool accepted = false ;
+    for (uint8_t i = 0 ; (i < mCount) && !accepted ; i++) {
+      const Rule & rule = mRules [i] ;
+      if ((key & rule.mIdentifierMask) == rule.mIdentifierValue) {
+        identifierMatches = true ;
+        accepted = ((inMessage.rtr ? 0 : inMessage.len) >= rule.mMinLength) // A remote frame has no data
+          && ((inMessage.data64 & rule.mDataMask) == rule.mDataValue)
+        ;
+      }
+    }
+    return accepted || !identifierMatches ;
+  }
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+  private: Rule * mRules = NULL ;
+  private: uint8_t mCapacity = 0 ;
+  private: uint8_t mCount = 0 ;
+
+//······················································································································
+//   NO COPY
+//······················································································································
+
+  private: ACAN2517ContentFilter (const ACAN2517ContentFilter &) = delete ;
+  private: ACAN2517ContentFilter & operator = (const ACAN2517ContentFilter &) = delete ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
@@ -0,0 +1,270 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// C++20 coroutine support (only available if the compiler implements coroutines):
+//   - ACAN2517Task is a fire and forget coroutine type, its frame is destroyed when the coroutine returns;
+//   - ACAN2517CoroutineScheduler::nextFrame awaits a frame accepted by a given hardware filter,
+//     ACAN2517CoroutineScheduler::sendConfirmed awaits the transmission of a message, via the transmit FIFO: it
+//     is confirmed when the controller transmit FIFO has transmitted it (transmittedSequence), so it does not
+//     wait for messages sent after it;
+//   - ACAN2517CoroutineScheduler::run resumes the coroutines, it should be called from loop, after poll if the
+//     driver is polled. Received frames that no coroutine awaits are dispatched by dispatchReceivedMessage; at
+//     most inMaxFrames frames are handled per call, so that run returns under sustained traffic.
+// Awaiters are linked in the scheduler lists, so no storage is allocated by the scheduler.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_COROUTINES_DEFINED
+#define ACAN2517_COROUTINES_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef __cpp_impl_coroutine
+#if __has_include (<coroutine>)
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517.h>
+#include <coroutine>
+#include <exception>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517Task: coroutine return type
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517Task {
+  public: class promise_type {
+    public: ACAN2517Task get_return_object (void) { return ACAN2517Task () ; }
+    public: std::suspend_never initial_suspend (void) noexcept { return {} ; }
+    public: std::suspend_never final_suspend (void) noexcept { return {} ; }
+    public: void return_void (void) {}
+    public: void unhandled_exception (void) { std::terminate () ; } // An exception must not vanish
+  } ;
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517CoroutineScheduler class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517CoroutineScheduler {
+
+//······················································································································
+//   CONSTANT
+//······················································································································
+
+  public: static const uint8_t kAnyFilter = 255 ;
+  public: static const uint32_t kDefaultTimeOutMS = 1000 ;
+
+//······················································································································
+//   AWAITER BASE CLASS (inTimeOutMS == 0 --> no time out)
+//······················································································································
+
+  public: class Awaiter {
+    protected: Awaiter (ACAN2517CoroutineScheduler & inScheduler, const uint32_t inTimeOutMS) :
+    mScheduler (inScheduler),
+    mStart (millis ()),
+    mTimeOut (inTimeOutMS) {
+    }
+
+    public: bool await_ready (void) const noexcept { return false ; }
+    public: bool await_resume (void) const noexcept { return mResult ; }
+
+    protected: bool timedOut (const uint32_t inNowMS) const {
+      return (mTimeOut > 0) && ((inNowMS - mStart) >= mTimeOut) ;
+    }
+
+    protected: ACAN2517CoroutineScheduler & mScheduler ;
+    protected: std::coroutine_handle <> mHandle ;
+    protected: Awaiter * mNext = NULL ;
+    protected: const uint32_t mStart ;
+    protected: const uint32_t mTimeOut ;
+    protected: bool mResult = false ;
+
+    friend class ACAN2517CoroutineScheduler ;
+  } ;
+
+//······················································································································
+//   FRAME AWAITER: resumes with true and the frame, or with false on time out
+//······················································································································
+
+  public: class FrameAwaiter : public Awaiter {
+    public: FrameAwaiter (ACAN2517CoroutineScheduler & inScheduler,
+                          CANMessage & outFrame,
+                          const uint8_t inFilterIndex,
+                          const uint32_t inTimeOutMS) :
+    Awaiter (inScheduler, inTimeOutMS),
+    mFrame (outFrame),
+    mFilterIndex (inFilterIndex) {
+    }
+
+    public: void await_suspend (std::coroutine_handle <> inHandle) {
+      mHandle = inHandle ;
+      mScheduler.enqueue (mScheduler.mFrameAwaiters, this) ;
+    }
+
+    private: CANMessage & mFrame ;
+    private: const uint8_t mFilterIndex ;
+
+    friend class ACAN2517CoroutineScheduler ;
+  } ;
+
+//······················································································································
+//   SEND AWAITER: resumes with true when the message has been transmitted, or with false on time out, if
+//   inMessage.idx is not 0, or if a transmission of the transmit FIFO has been aborted while it was pending
+//······················································································································
+
+  public: class SendAwaiter : public Awaiter {
+    public: SendAwaiter (ACAN2517CoroutineScheduler & inScheduler,
+                         const CANMessage & inMessage,
+                         const uint32_t inTimeOutMS) :
+    Awaiter (inScheduler, inTimeOutMS),
+    mMessage (inMessage) {
+    }
+
+    public: void await_suspend (std::coroutine_handle <> inHandle) {
+      mHandle = inHandle ;
+      mScheduler.enqueue (mScheduler.mSendAwaiters, this) ;
+    }
+
+    private: const CANMessage mMessage ;
+    private: uint32_t mSequence = 0 ; // Transmit sequence number, valid when mQueued is true
+    private: bool mQueued = false ; // true when the message is in the driver transmit buffer
+
+    friend class ACAN2517CoroutineScheduler ;
+  } ;
+
+//······················································································································
+//   CONSTRUCTOR
+//······················································································································
+
+  public: ACAN2517CoroutineScheduler (ACAN2517 & inDriver) : mDriver (inDriver) {}
+
+//······················································································································
+//   AWAITABLES (inFilterIndex: 0 ... 31, or kAnyFilter; inTimeOutMS == 0 --> no time out)
+//······················································································································
+
+  public: FrameAwaiter nextFrame (CANMessage & outFrame,
+                                  const uint8_t inFilterIndex = kAnyFilter,
+                                  const uint32_t inTimeOutMS = kDefaultTimeOutMS) {
+    return FrameAwaiter (*this, outFrame, inFilterIndex, inTimeOutMS) ;
+  }
+
+  public: SendAwaiter sendConfirmed (const CANMessage & inMessage, const uint32_t inTimeOutMS = kDefaultTimeOutMS) {
+    return SendAwaiter (*this, inMessage, inTimeOutMS) ;
+  }
+
+//······················································································································
+//   RUN: delivers at most inMaxFrames received frames, then checks transmissions and time outs
+//······················································································································
+
+  public: void run (const uint32_t inMaxFrames = 32) {
+  //--- Received frames, oldest awaiter first
+    uint32_t frameCount = 0 ;
+    const CANMessage * frame = (inMaxFrames > 0) ? mDriver.peek () : NULL ;
+    while (frame != NULL) {
+      Awaiter ** awaiterPtr = & mFrameAwaiters ;
+      while ((*awaiterPtr != NULL) && !accepts (* (FrameAwaiter *) *awaiterPtr, *frame)) {
+        awaiterPtr = & (*awaiterPtr)->mNext ;
+      }
+      if (*awaiterPtr != NULL) {
+        FrameAwaiter * awaiter = (FrameAwaiter *) *awaiterPtr ;
+        *awaiterPtr = awaiter->mNext ;
+        awaiter->mFrame = *frame ;
+        mDriver.consume (1) ;
+        resume (awaiter, true) ;
+      }else{
+        mDriver.dispatchReceivedMessage () ;
+      }
+      frameCount += 1 ;
+      frame = (frameCount < inMaxFrames) ? mDriver.peek () : NULL ;
+    }
+  //--- Transmissions: the status is read once, before queuing new messages, so that an abort only fails the
+  //    messages that were pending when it occurred
+    const uint32_t now = millis () ;
+    bool aborted = false ;
+    const uint32_t transmittedSequence = (mSendAwaiters != NULL) ? mDriver.transmittedSequence (aborted) : 0 ;
+    Awaiter ** awaiterPtr = & mSendAwaiters ;
+    while (*awaiterPtr != NULL) {
+      SendAwaiter * awaiter = (SendAwaiter *) *awaiterPtr ;
+      bool done = false ;
+      bool failed = false ;
+      if (awaiter->mQueued) {
+        done = (int32_t) (transmittedSequence - awaiter->mSequence) >= 0 ;
+        failed = !done && aborted ;
+      }else if (awaiter->mMessage.idx != 0) { // Only messages of the transmit FIFO can be confirmed
+        failed = true ;
+      }else{
+        awaiter->mQueued = mDriver.tryToSend (awaiter->mMessage, awaiter->mSequence) ;
+      }
+      if (done || failed || awaiter->timedOut (now)) {
+        *awaiterPtr = awaiter->mNext ;
+        resume (awaiter, done) ;
+      }else{
+        awaiterPtr = & awaiter->mNext ;
+      }
+    }
+  //--- Frame time outs
+    awaiterPtr = & mFrameAwaiters ;
+    while (*awaiterPtr != NULL) {
+      Awaiter * awaiter = *awaiterPtr ;
+      if (awaiter->timedOut (now)) {
+        *awaiterPtr = awaiter->mNext ;
+        resume (awaiter, false) ;
+      }else{
+        awaiterPtr = & awaiter->mNext ;
+      }
+    }
+  }
+
+//······················································································································
+//   PRIVATE METHODS
+//······················································································································
+
+  private: static bool accepts (const FrameAwaiter & inAwaiter, const CANMessage & inFrame) {
+    return (inAwaiter.mFilterIndex == kAnyFilter) || (inAwaiter.mFilterIndex == inFrame.idx) ;
+  }
+
+//--- Awaiters are appended, so that the oldest one gets the frame
+  private: void enqueue (Awaiter * & ioList, Awaiter * inAwaiter) {
+    Awaiter ** awaiterPtr = & ioList ;
+    while (*awaiterPtr != NULL) {
+      awaiterPtr = & (*awaiterPtr)->mNext ;
+    }
+    inAwaiter->mNext = NULL ;
+    *awaiterPtr = inAwaiter ;
+  }
+
+//--- The awaiter is already removed from its list: the resumed coroutine may await again, or return
+  private: static void resume (Awaiter * inAwaiter, const bool inResult) {
+    inAwaiter->mResult = inResult ;
+    inAwaiter->mHandle.resume () ;
+  }
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+  private: ACAN2517 & mDriver ;
+  private: Awaiter * mFrameAwaiters = NULL ;
+  private: Awaiter * mSendAwaiters = NULL ;
+
+//······················································································································
+//   NO COPY
+//······················································································································
+
+  private: ACAN2517CoroutineScheduler (const ACAN2517CoroutineScheduler &) = delete ;
+  private: ACAN2517CoroutineScheduler & operator = (const ACAN2517CoroutineScheduler &) = delete ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
+#endif
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
@@ -0,0 +1,119 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Decimation table, checked by receiveInterrupt: for every registered identifier, either one frame out of N is kept,
+// or at most one frame per interval (in µs). Storage is allocated once, by initWithSize.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_DECIMATION_TABLE_CLASS_DEFINED
+#define ACAN2517_DECIMATION_TABLE_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517IdentifierMap.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517DecimationTable class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517DecimationTable {
+
+//······················································································································
+//   EMBEDDED CLASS
+//······················································································································
+
+  private: class Entry {
+    public: uint32_t mMinInterval = 0 ; // In µs, 0 --> decimation by mRatio
+    public: uint32_t mKeepDate = 0 ; // Date of last kept frame
+    public: uint16_t mRatio = 1 ; // One frame out of mRatio is kept
+    public: uint16_t mCounter = 0 ; // Frames since last kept frame
+    public: bool mKept = false ; // false until a frame is kept
+  } ;
+
+//······················································································································
+//   CONSTRUCTOR
+//······················································································································
+
+  public: ACAN2517DecimationTable (void) {}
+
+//······················································································································
+//   DESTRUCTOR
+//······················································································································
+
+  public: ~ ACAN2517DecimationTable (void) {
+    delete [] mEntries ;
+  }
+
+//······················································································································
+//   INIT
+//······················································································································
+
+  public: void initWithSize (const uint16_t inCapacity) {
+    mMap.initWithCapacity (inCapacity) ;
+    mEntries = new Entry [inCapacity] ;
+  }
+
+//······················································································································
+//   ADD AN IDENTIFIER (returns false if there is no room left); inMinInterval == 0 --> decimation by inRatio
+//······················································································································
+
+  public: bool add (const uint32_t inKey, const uint16_t inRatio, const uint32_t inMinInterval) {
+    const uint16_t index = mMap.slot (inKey) ;
+    const bool ok = index != ACAN2517IdentifierMap::kNone ;
+    if (ok) {
+      mEntries [index] = Entry () ;
+      mEntries [index].mRatio = (inRatio == 0) ? 1 : inRatio ;
+      mEntries [index].mMinInterval = inMinInterval ;
+    }
+    return ok ;
+  }
+
+//······················································································································
+//   DECIMATION CHECK (inNow in µs, only used for interval rules)
+//······················································································································
+
+  public: inline bool drops (const CANMessage & inMessage, const uint32_t inNow) {
+    const uint16_t index = mMap.find (ACAN2517IdentifierMap::key (inMessage)) ;
+    bool drop = false ;
+    if (index != ACAN2517IdentifierMap::kNone) {
+      Entry & entry = mEntries [index] ;
+      if (entry.mMinInterval > 0) {
+        drop = entry.mKept && ((inNow - entry.mKeepDate) < entry.mMinInterval) ;
+        if (!drop) {
+          entry.mKeepDate = inNow ;
+          entry.mKept = true ;
+        }
+      }else{
+        drop = entry.mCounter != 0 ;
+        entry.mCounter += 1 ;
+        if (entry.mCounter >= entry.mRatio) {
+          entry.mCounter = 0 ;
+        }
+      }
+    }
+    return drop ;
+  }
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+  private: ACAN2517IdentifierMap mMap ; // Identifier -> index in mEntries
+  private: Entry * mEntries = NULL ;
+
+//······················································································································
+//   NO COPY
+//······················································································································
+
+  private: ACAN2517DecimationTable (const ACAN2517DecimationTable &) = delete ;
+  private: ACAN2517DecimationTable & operator = (const ACAN2517DecimationTable &) = delete ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
@@ -0,0 +1,120 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Deny list, checked by receiveInterrupt: a bitmap for standard identifiers (256 bytes), a hash set for extended
+// identifiers. Both lookups are O(1). Storage is allocated once, by initWithSize.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_DENY_LIST_CLASS_DEFINED
+#define ACAN2517_DENY_LIST_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517IdentifierMap.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517DenyList class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517DenyList {
+
+//······················································································································
+//   CONSTRUCTOR
+//······················································································································
+
+  public: ACAN2517DenyList (void) {}
+
+//······················································································································
+//   DESTRUCTOR
+//······················································································································
+
+  public: ~ ACAN2517DenyList (void) {
+    delete [] mStandardBitmap ;
+  }
+
+//······················································································································
+//   INIT
+//······················································································································
+
+  public: void initWithSize (const bool inStandard, const uint16_t inExtendedCapacity) {
+    if (inStandard) {
+      mStandardBitmap = new uint8_t [256] ;
+      for (uint16_t i = 0 ; i < 256 ; i++) {
+        mStandardBitmap [i] = 0 ;
+      }
+    }
+    if (inExtendedCapacity > 0) {
+      mExtendedSet.initWithCapacity (inExtendedCapacity) ;
+    }
+  }
+
+//······················································································································
+//   ADD, REMOVE (return false if identifier is too large, or if there is no room)
+//······················································································································
+
+  public: bool add (const bool inExtended, const uint32_t inIdentifier) {
+    bool ok ;
+    if (inExtended) {
+      ok = (inIdentifier <= 0x1FFFFFFF) && mExtendedSet.insert (inIdentifier, 0) ;
+    }else{
+      ok = (inIdentifier <= 0x7FF) && (mStandardBitmap != NULL) ;
+      if (ok) {
+        mStandardBitmap [inIdentifier >> 3] |= (uint8_t) (1 << (inIdentifier & 7)) ;
+      }
+    }
+    return ok ;
+  }
+
+//······················································································································
+
+  public: bool remove (const bool inExtended, const uint32_t inIdentifier) {
+    bool ok ;
+    if (inExtended) {
+      ok = mExtendedSet.remove (inIdentifier) ;
+    }else{
+      ok = (inIdentifier <= 0x7FF) && (mStandardBitmap != NULL) ;
+      if (ok) {
+        mStandardBitmap [inIdentifier >> 3] &= (uint8_t) ~ (1 << (inIdentifier & 7)) ;
+      }
+    }
+    return ok ;
+  }
+
+//······················································································································
+//   LOOKUP
+//······················································································································
+
+  public: inline bool contains (const CANMessage & inMessage) const {
+    bool result ;
+    if (inMessage.ext) {
+      result = mExtendedSet.find (inMessage.id) != ACAN2517IdentifierMap::kNone ;
+    }else{
+      result = (mStandardBitmap != NULL)
+        && ((mStandardBitmap [(inMessage.id >> 3) & 0xFF] & (1 << (inMessage.id & 7))) != 0) ;
+    }
+    return result ;
+  }
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+  private: uint8_t * mStandardBitmap = NULL ; // NULL if no standard identifier can be denied
+  private: ACAN2517IdentifierMap mExtendedSet ; // Value is unused
+
+//······················································································································
+//   NO COPY
+//······················································································································
+
+  private: ACAN2517DenyList (const ACAN2517DenyList &) = delete ;
+  private: ACAN2517DenyList & operator = (const ACAN2517DenyList &) = delete ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
@@ -0,0 +1,151 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// A frame already encoded in the MCP2517FD transmit message object layout (DS20005678B, page 27): the extended
+// identifier bit reordering and the DLC / RTR / IDE flag word are computed once (at compile time if the object
+// is constexpr); sending it is a plain copy of the 16 bytes into the SPI buffer.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_ENCODED_FRAME_CLASS_DEFINED
+#define ACAN2517_ENCODED_FRAME_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <CANMessage.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517EncodedFrame class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517EncodedFrame {
+
+//······················································································································
+//   CONSTRUCTORS
+//······················································································································
+
+//--- Standard data frame, identifier 0, no data
+  public: constexpr ACAN2517EncodedFrame (void) :
+  mObject {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0} {
+  }
+
+//--- inData: data byte i is (inData >> (8 * i)) & 0xFF (this is CANMessage::data64 on little endian processors)
+  public: constexpr ACAN2517EncodedFrame (const tFrameFormat inFormat,
+                                          const uint32_t inIdentifier,
+                                          const uint8_t inLength = 0,
+                                          const uint64_t inData = 0,
+                                          const tFrameKind inKind = kData) :
+  mObject {
+    byteOf (identifierWord (inFormat, inIdentifier), 0),
+    byteOf (identifierWord (inFormat, inIdentifier), 1),
+    byteOf (identifierWord (inFormat, inIdentifier), 2),
+    byteOf (identifierWord (inFormat, inIdentifier), 3),
+    byteOf (flagWord (inFormat, inKind, inLength), 0),
+    byteOf (flagWord (inFormat, inKind, inLength), 1),
+    byteOf (flagWord (inFormat, inKind, inLength), 2),
+    byteOf (flagWord (inFormat, inKind, inLength), 3),
+    (uint8_t) inData,
+    (uint8_t) (inData >>  8),
+    (uint8_t) (inData >> 16),
+    (uint8_t) (inData >> 24),
+    (uint8_t) (inData >> 32),
+    (uint8_t) (inData >> 40),
+    (uint8_t) (inData >> 48),
+    (uint8_t) (inData >> 56)
+  } {
+  }
+
+//--- Run time encoding of a message
+  public: explicit ACAN2517EncodedFrame (const CANMessage & inMessage) :
+  mObject () {
+    const uint32_t idf = identifierWord (inMessage.ext ? kExtended : kStandard, inMessage.id) ;
+    const uint32_t flags = flagWord (inMessage.ext ? kExtended : kStandard,
+                                     inMessage.rtr ? kRemote : kData,
+                                     inMessage.len) ;
+    for (uint8_t i = 0 ; i < 4 ; i++) {
+      mObject [i] = byteOf (idf, i) ;
+      mObject [4 + i] = byteOf (flags, i) ;
+    }
+    for (uint8_t i = 0 ; i < 8 ; i++) {
+      mObject [8 + i] = inMessage.data [i] ;
+    }
+  }
+
+//······················································································································
+//   ENCODING (DS20005678B, page 27)
+//······················································································································
+
+  public: static constexpr uint32_t identifierWord (const tFrameFormat inFormat, const uint32_t inIdentifier) {
+    return (inFormat == kExtended)
+      ? (((inIdentifier >> 18) & 0x7FF) | ((inIdentifier & 0x3FFFF) << 11))
+      : (inIdentifier & 0x7FF)
+    ;
+  }
+
+  public: static constexpr uint32_t flagWord (const tFrameFormat inFormat,
+                                              const tFrameKind inKind,
+                                              const uint8_t inLength) {
+    return ((inLength > 8) ? 8 : inLength)
+      | ((inKind == kRemote) ? (1 << 5) : 0) // RTR bit
+      | ((inFormat == kExtended) ? (1 << 4) : 0) // IDE bit
+    ;
+  }
+
+  private: static constexpr uint8_t byteOf (const uint32_t inWord, const uint8_t inIndex) {
+    return (uint8_t) (inWord >> (8 * inIndex)) ;
+  }
+
+//······················································································································
+//   ACCESSORS
+//······················································································································
+
+  public: const uint8_t * object (void) const { return mObject ; }
+
+  public: bool isExtended (void) const { return (mObject [4] & (1 << 4)) != 0 ; }
+
+//--- Decoded message (used when the frame has to wait in the driver transmit buffer)
+  public: CANMessage message (void) const {
+    CANMessage result ;
+    uint32_t idf = 0 ;
+    for (uint8_t i = 0 ; i < 4 ; i++) {
+      idf |= ((uint32_t) mObject [i]) << (8 * i) ;
+    }
+    result.ext = isExtended () ;
+    result.rtr = (mObject [4] & (1 << 5)) != 0 ;
+    result.len = mObject [4] & 0x0F ;
+    result.id = result.ext ? (((idf >> 11) & 0x3FFFF) | ((idf & 0x7FF) << 18)) : idf ;
+    for (uint8_t i = 0 ; i < 8 ; i++) {
+      result.data [i] = mObject [8 + i] ;
+    }
+    return result ;
+  }
+
+//······················································································································
+//   DATA
+//······················································································································
+
+  public: void setData (const uint8_t inIndex, const uint8_t inValue) {
+    if (inIndex < 8) {
+      mObject [8 + inIndex] = inValue ;
+    }
+  }
+
+  public: uint8_t data (const uint8_t inIndex) const {
+    return (inIndex < 8) ? mObject [8 + inIndex] : 0 ;
+  }
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+//--- T0 (identifier), T1 (flags), data bytes: MCP2517FD RAM byte order
+  private: uint8_t mObject [16] ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
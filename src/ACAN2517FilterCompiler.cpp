@@ -0,0 +1,291 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517FilterCompiler.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//    IDENTIFIER MASKS
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+static const uint32_t STANDARD_IDENTIFIER_MASK = 0x7FF ;
+static const uint32_t EXTENDED_IDENTIFIER_MASK = 0x1FFFFFFF ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+static uint32_t identifierMask (const bool inExtended) {
+  return inExtended ? EXTENDED_IDENTIFIER_MASK : STANDARD_IDENTIFIER_MASK ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+static uint8_t bitCount (uint32_t inValue) {
+  uint8_t result = 0 ;
+  while (inValue != 0) {
+    inValue &= inValue - 1 ;
+    result += 1 ;
+  }
+  return result ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//   CONSTRUCTOR
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+ACAN2517FilterCompiler::ACAN2517FilterCompiler (const uint16_t inCapacity) :
+mTerms (new Term [inCapacity]),
+mCapacity (inCapacity) {
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//   DESTRUCTOR
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+ACAN2517FilterCompiler::~ ACAN2517FilterCompiler (void) {
+  delete [] mTerms ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//   SIZE AND INCLUSION
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517FilterCompiler::size (const Term & inTerm) {
+  const uint8_t freeBits = bitCount (identifierMask (inTerm.mExtended) & ~ inTerm.mMask) ;
+  return ((uint32_t) 1) << freeBits ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+static bool includes (const bool inExtendedA, const uint32_t inMaskA, const uint32_t inValueA,
+                      const bool inExtendedB, const uint32_t inMaskB, const uint32_t inValueB) {
+  return (inExtendedA == inExtendedB)
+    && ((inMaskA & ~ inMaskB) == 0)
+    && ((inValueB & inMaskA) == inValueA)
+  ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//   WANTED IDENTIFIERS
+// Wanted terms are aligned blocks: two of them are either disjoint, or one includes the other. So a term included
+// in an appended one is removed, and the wanted identifier count is exact.
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517FilterCompiler::appendTerm (const bool inExtended, const uint32_t inMask, const uint32_t inValue) {
+  bool ok = !mCompiled ;
+  const uint32_t value = inValue & inMask ;
+  bool included = false ;
+  for (uint16_t i = 0 ; (i < mTermCount) && !included ; i++) {
+    const Term & t = mTerms [i] ;
+    included = includes (t.mExtended, t.mMask, t.mValue, inExtended, inMask, value) ;
+  }
+  if (ok && !included) {
+  //--- Remove included terms: if any, there is room for the new term
+    uint16_t k = 0 ;
+    while (k < mTermCount) {
+      const Term & t = mTerms [k] ;
+      if (includes (inExtended, inMask, value, t.mExtended, t.mMask, t.mValue)) {
+        mWantedCount -= size (t) ;
+        mTermCount -= 1 ;
+        mTerms [k] = mTerms [mTermCount] ;
+      }else{
+        k += 1 ;
+      }
+    }
+    ok = mTermCount < mCapacity ;
+    if (ok) {
+      Term & term = mTerms [mTermCount] ;
+      term.mExtended = inExtended ;
+      term.mMask = inMask ;
+      term.mValue = value ;
+      mTermCount += 1 ;
+      mWantedCount += size (term) ;
+    }
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517FilterCompiler::appendFrame (const tFrameFormat inFormat, const uint32_t inIdentifier) {
+  const bool extended = inFormat == kExtended ;
+  return (inIdentifier <= identifierMask (extended))
+    && appendTerm (extended, identifierMask (extended), inIdentifier) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// A range is decomposed into the largest aligned blocks: a block of 2^k identifiers starting at a multiple of 2^k
+// is the mask / acceptance pair whose k lower mask bits are cleared (the full range is a single block).
+
+static uint32_t alignedBlockSize (const uint32_t inFirst, const uint32_t inLast, const uint32_t inFullMask) {
+  uint32_t blockSize = 1 ;
+  while (((2 * blockSize - 1) <= inFullMask)
+      && ((inFirst & (2 * blockSize - 1)) == 0)
+      && ((inFirst + 2 * blockSize - 1) <= inLast)) {
+    blockSize *= 2 ;
+  }
+  return blockSize ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517FilterCompiler::appendRange (const tFrameFormat inFormat,
+                                          const uint32_t inFirst,
+                                          const uint32_t inLast) {
+  const bool extended = inFormat == kExtended ;
+  const uint32_t fullMask = identifierMask (extended) ;
+  bool ok = (inFirst <= inLast) && (inLast <= fullMask) && !mCompiled ;
+//--- Check there is room for all blocks first, so that a failed append leaves no partial range
+  if (ok) {
+    uint32_t blockCount = 0 ;
+    uint32_t first = inFirst ;
+    bool loop = true ;
+    while (loop) {
+      const uint32_t last = first + alignedBlockSize (first, inLast, fullMask) - 1 ;
+      blockCount += 1 ;
+      loop = last < inLast ;
+      first = last + 1 ;
+    }
+    ok = (mTermCount + blockCount) <= mCapacity ;
+  }
+  uint32_t first = inFirst ;
+  bool loop = ok ;
+  while (loop) {
+    const uint32_t blockSize = alignedBlockSize (first, inLast, fullMask) ;
+    appendTerm (extended, fullMask & ~ (blockSize - 1), first) ;
+    const uint32_t last = first + blockSize - 1 ;
+    loop = last < inLast ;
+    first = last + 1 ;
+  }
+  return ok ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool ACAN2517FilterCompiler::appendFormat (const tFrameFormat inFormat) {
+  return appendTerm (inFormat == kExtended, 0, 0) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//   COMPILE (wanted identifier count was computed by append, it is unchanged by merges)
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517FilterCompiler::compile (const uint8_t inMaxFilterCount) {
+  mCompiled = true ;
+//--- Greedy merge
+  bool loop = mTermCount > inMaxFilterCount ;
+  while (loop) {
+    uint32_t bestCost = UINT32_MAX ;
+    uint16_t bestI = 0 ;
+    uint16_t bestJ = 0 ;
+    for (uint16_t i = 0 ; i < mTermCount ; i++) {
+      const Term & a = mTerms [i] ;
+      const uint32_t sizeA = size (a) ;
+      for (uint16_t j = i + 1 ; j < mTermCount ; j++) {
+        const Term & b = mTerms [j] ;
+        if (a.mExtended == b.mExtended) {
+          Term merged ;
+          merged.mExtended = a.mExtended ;
+          merged.mMask = a.mMask & b.mMask & ~ (a.mValue ^ b.mValue) ;
+          const uint32_t mergedSize = size (merged) ;
+          const uint32_t sizeAB = sizeA + size (b) ;
+          const uint32_t cost = (mergedSize > sizeAB) ? (mergedSize - sizeAB) : 0 ;
+          if (cost < bestCost) {
+            bestCost = cost ;
+            bestI = i ;
+            bestJ = j ;
+          }
+        }
+      }
+    }
+    loop = bestCost != UINT32_MAX ; // false if no two terms have the same format
+    if (loop) {
+      Term merged = mTerms [bestI] ;
+      merged.mMask &= mTerms [bestJ].mMask & ~ (merged.mValue ^ mTerms [bestJ].mValue) ;
+      merged.mValue &= merged.mMask ;
+    //--- Remove both terms (bestJ > bestI), and every term included in the merged term
+      mTermCount -= 1 ;
+      mTerms [bestJ] = mTerms [mTermCount] ;
+      mTermCount -= 1 ;
+      mTerms [bestI] = mTerms [mTermCount] ;
+      uint16_t k = 0 ;
+      while (k < mTermCount) {
+        const Term & t = mTerms [k] ;
+        if (includes (merged.mExtended, merged.mMask, merged.mValue, t.mExtended, t.mMask, t.mValue)) {
+          mTermCount -= 1 ;
+          mTerms [k] = mTerms [mTermCount] ;
+        }else{
+          k += 1 ;
+        }
+      }
+      mTerms [mTermCount] = merged ;
+      mTermCount += 1 ;
+      loop = mTermCount > inMaxFilterCount ;
+    }
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//   RESULT
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517FilterCompiler::getFilter (const uint16_t inIndex,
+                                        tFrameFormat & outFormat,
+                                        uint32_t & outMask,
+                                        uint32_t & outAcceptance) const {
+  if (inIndex < mTermCount) {
+    const Term & t = mTerms [inIndex] ;
+    outFormat = t.mExtended ? kExtended : kStandard ;
+    outMask = t.mMask ;
+    outAcceptance = t.mValue ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+void ACAN2517FilterCompiler::appendFiltersTo (ACAN2517Filters & ioFilters,
+                                              const ACANCallBackRoutine inCallBackRoutine) const {
+  for (uint16_t i = 0 ; i < mTermCount ; i++) {
+    const Term & t = mTerms [i] ;
+    ioFilters.appendFilter (t.mExtended ? kExtended : kStandard, t.mMask, t.mValue, inCallBackRoutine) ;
+  }
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+uint32_t ACAN2517FilterCompiler::admittedCount (void) const {
+  uint32_t result = 0 ;
+//--- Standard identifiers: exact count
+  for (uint32_t identifier = 0 ; identifier <= STANDARD_IDENTIFIER_MASK ; identifier++) {
+    bool admitted = false ;
+    for (uint16_t i = 0 ; (i < mTermCount) && !admitted ; i++) {
+      const Term & t = mTerms [i] ;
+      admitted = !t.mExtended && ((identifier & t.mMask) == t.mValue) ;
+    }
+    if (admitted) {
+      result += 1 ;
+    }
+  }
+//--- Extended identifiers: sum of filter sizes
+  for (uint16_t i = 0 ; i < mTermCount ; i++) {
+    if (mTerms [i].mExtended) {
+      result += size (mTerms [i]) ;
+    }
+  }
+  return result ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+float ACAN2517FilterCompiler::falsePositiveFraction (void) const {
+  const uint32_t admitted = admittedCount () ;
+  return ((admitted == 0) || (admitted <= mWantedCount))
+    ? 0.0f
+    : ((float) (admitted - mWantedCount) / (float) admitted)
+  ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
@@ -0,0 +1,121 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Filter compiler: from a set of identifiers, identifier ranges and formats, computes at most N mask / acceptance
+// pairs (N <= 32) that accept every wanted identifier and as few unwanted identifiers as possible.
+//   - a range is decomposed into aligned blocks (identifier prefixes), that are mask / acceptance pairs;
+//   - while there are more than N pairs, the two pairs of same format whose merge admits the fewest new
+//     identifiers are merged (for pairs of same mask, this is the pair with the smallest Hamming distance);
+//     pairs included in the merged pair are removed.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_FILTER_COMPILER_CLASS_DEFINED
+#define ACAN2517_FILTER_COMPILER_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517Filters.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517FilterCompiler class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517FilterCompiler {
+
+//······················································································································
+//   EMBEDDED CLASS
+//······················································································································
+
+  private: class Term {
+    public: uint32_t mMask = 0 ; // Identifier bits (not reordered), 1 --> bit is compared
+    public: uint32_t mValue = 0 ;
+    public: bool mExtended = false ;
+  } ;
+
+//······················································································································
+//   CONSTRUCTOR (inCapacity: maximum number of identifiers and aligned blocks)
+//······················································································································
+
+  public: ACAN2517FilterCompiler (const uint16_t inCapacity) ;
+
+//······················································································································
+//   DESTRUCTOR
+//······················································································································
+
+  public: ~ ACAN2517FilterCompiler (void) ;
+
+//······················································································································
+//   WANTED IDENTIFIERS (return false if identifier is too large, if capacity is exceeded, or after compile:
+//   call clear first). A range that does not fit is not appended at all.
+//······················································································································
+
+  public: bool appendFrame (const tFrameFormat inFormat, const uint32_t inIdentifier) ;
+
+  public: bool appendRange (const tFrameFormat inFormat, const uint32_t inFirst, const uint32_t inLast) ;
+
+  public: bool appendFormat (const tFrameFormat inFormat) ;
+
+  public: void clear (void) { mTermCount = 0 ; mWantedCount = 0 ; mCompiled = false ; }
+
+//······················································································································
+//   COMPILE (at most inMaxFilterCount filters; if both formats are wanted, at least 2 filters are needed)
+//   It can be called again with a lower inMaxFilterCount
+//······················································································································
+
+  public: void compile (const uint8_t inMaxFilterCount = 32) ;
+
+//--- Append compiled filters, all with the same call back routine
+  public: void appendFiltersTo (ACAN2517Filters & ioFilters, const ACANCallBackRoutine inCallBackRoutine) const ;
+
+//······················································································································
+//   RESULT
+//······················································································································
+
+  public: uint16_t filterCount (void) const { return mTermCount ; }
+
+  public: void getFilter (const uint16_t inIndex,
+                          tFrameFormat & outFormat,
+                          uint32_t & outMask,
+                          uint32_t & outAcceptance) const ;
+
+//--- Number of wanted identifiers, number of identifiers accepted by the compiled filters
+  public: uint32_t wantedCount (void) const { return mWantedCount ; }
+  public: uint32_t admittedCount (void) const ;
+
+//--- Unwanted identifiers / admitted identifiers. Exact for standard identifiers; for extended identifiers,
+//    filters that partially overlap are counted twice, so the result is an upper bound.
+  public: float falsePositiveFraction (void) const ;
+
+//······················································································································
+//   PRIVATE METHODS
+//······················································································································
+
+  private: bool appendTerm (const bool inExtended, const uint32_t inMask, const uint32_t inValue) ;
+  private: static uint32_t size (const Term & inTerm) ;
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+  private: Term * mTerms ;
+  private: uint16_t mCapacity ;
+  private: uint16_t mTermCount = 0 ;
+  private: uint32_t mWantedCount = 0 ;
+  private: bool mCompiled = false ; // Terms are merged, appending is not allowed until clear
+
+//······················································································································
+//   NO COPY
+//······················································································································
+
+  private: ACAN2517FilterCompiler (const ACAN2517FilterCompiler &) = delete ;
+  private: ACAN2517FilterCompiler & operator = (const ACAN2517FilterCompiler &) = delete ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
@@ -147,65 +147,91 @@ class ACAN2517Filters {
                              const uint32_t inMask,
                              const uint32_t inAcceptance,
                              const ACANCallBackRoutine inCallBackRoutine) {
+  //--- Check filter
+    const FilterStatus status = checkFilter (inFormat, inMask, inAcceptance) ;
+    if (status != kFiltersOk) {
+      mFilterStatus = status ;
+      mFilterErrorIndex = mFilterCount ;
+    }
+  //--- Re order bits if extended filter
+    const uint32_t mask = filterMask (inFormat, inMask) ;
+    const uint32_t acceptance = acceptanceFilter (inFormat, inAcceptance) ;
+  //--- Enter filter
+    Filter * f = new Filter (mask, acceptance, inCallBackRoutine) ;
+    if (mFirstFilter == NULL) {
+      mFirstFilter = f ;
+    }else{
+      mLastFilter->mNextFilter  = f ;
+    }
+    mLastFilter = f ;
+    mFilterCount += 1 ;
+  }
+
+//······················································································································
+//   ACCESSORS
+//······················································································································
+
+  public: FilterStatus filterStatus (void) const { return mFilterStatus ; }
+
+  public: uint8_t filterErrorIndex (void) const { return mFilterErrorIndex ; }
+
+  public: uint8_t filterCount (void) const { return mFilterCount ; }
+
+//······················································································································
+//   FILTER ENCODING (also used by ACAN2517::replaceFilter)
+//······················································································································
+
+  private: static FilterStatus checkFilter (const tFrameFormat inFormat,
+                                            const uint32_t inMask,
+                                            const uint32_t inAcceptance) {
+    FilterStatus status = kFiltersOk ;
   //--- Check consistency between mask and acceptance
     if ((inMask & inAcceptance) != inAcceptance) {
-      mFilterStatus = kInconsistencyBetweenMaskAndAcceptance ;
-      mFilterErrorIndex = mFilterCount ;
+      status = kInconsistencyBetweenMaskAndAcceptance ;
     }
   //--- Check identifier
     if (inFormat == kExtended) {
       if (inAcceptance > 0x1FFFFFFF) {
-        mFilterStatus = kExtendedAcceptanceTooLarge ;
-        mFilterErrorIndex = mFilterCount ;
+        status = kExtendedAcceptanceTooLarge ;
       }
     }else if (inAcceptance > 0x7FF) {
-      mFilterStatus = kStandardAcceptanceTooLarge ;
-      mFilterErrorIndex = mFilterCount ;
+      status = kStandardAcceptanceTooLarge ;
     }
   //--- Check mask
     if (inFormat == kExtended) {
       if (inMask > 0x1FFFFFFF) {
-        mFilterStatus = kExtendedMaskTooLarge ;
-        mFilterErrorIndex = mFilterCount ;
+        status = kExtendedMaskTooLarge ;
       }
     }else if (inMask > 0x7FF) {
-      mFilterStatus = kStandardMaskTooLarge ;
-      mFilterErrorIndex = mFilterCount ;
+      status = kStandardMaskTooLarge ;
     }
-  //--- Re order bits if extended filter
+    return status ;
+  }
+
+//······················································································································
+
+  private: static uint32_t filterMask (const tFrameFormat inFormat, const uint32_t inMask) { // C1MASK value
     uint32_t mask = ((uint32_t) 1) << 30 ;
     if (inFormat == kExtended) {
       mask |= ((inMask >> 18) & 0x7FF) | ((inMask & 0x3FFFF) << 11) ;
     }else{
       mask |= inMask ;
     }
+    return mask ;
+  }
+
+//······················································································································
+
+  private: static uint32_t acceptanceFilter (const tFrameFormat inFormat, const uint32_t inAcceptance) { // C1FLTOBJ value
     uint32_t acceptance ;
     if (inFormat == kExtended) {
       acceptance = ((inAcceptance >> 18) & 0x7FF) | ((inAcceptance & 0x3FFFF) << 11) | (((uint32_t) 1) << 30) ;
     }else{
       acceptance = inAcceptance ;
     }
-  //--- Enter filter
-    Filter * f = new Filter (mask, acceptance, inCallBackRoutine) ;
-    if (mFirstFilter == NULL) {
-      mFirstFilter = f ;
-    }else{
-      mLastFilter->mNextFilter  = f ;
-    }
-    mLastFilter = f ;
-    mFilterCount += 1 ;
+    return acceptance ;
   }
 
-//······················································································································
-//   ACCESSORS
-//······················································································································
-
-  public: FilterStatus filterStatus (void) const { return mFilterStatus ; }
-
-  public: uint8_t filterErrorIndex (void) const { return mFilterErrorIndex ; }
-
-  public: uint8_t filterCount (void) const { return mFilterCount ; }
-
 //······················································································································
 //   PRIVATE PROPERTIES
 //······················································································································
@@ -0,0 +1,87 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Handler table: a compile time list of handlers (lambdas, functors, functions), handler #i is called for messages
+// accepted by filter #i. The handler types are template arguments, so the dispatch is a chain of index comparisons
+// with direct (inlinable) calls, instead of an indirect call through the call back array.
+//
+//   auto handlers = makeHandlerTable (
+//     [] (const CANMessage & inMessage) { ... }, // Filter #0
+//     [&counter] (const CANMessage &) { counter += 1 ; } // Filter #1
+//   ) ;
+//   ...
+//   can.dispatchReceivedMessage (handlers) ;
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_HANDLER_TABLE_CLASS_DEFINED
+#define ACAN2517_HANDLER_TABLE_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <CANMessage.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517HandlerTable class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+template <typename... HANDLERS> class ACAN2517HandlerTable ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  Empty table: no handler for the filter
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+template <> class ACAN2517HandlerTable <> {
+
+  public: ACAN2517HandlerTable (void) {}
+
+//--- Returns false if there is no handler for filter inFilterIndex
+  public: inline bool handle (const uint32_t /* inFilterIndex */, const CANMessage & /* inMessage */) {
+    return false ;
+  }
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  Non empty table: first handler is for filter index 0, remaining handlers for the following indexes
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+template <typename HANDLER, typename... OTHER_HANDLERS>
+class ACAN2517HandlerTable <HANDLER, OTHER_HANDLERS...> {
+
+  public: ACAN2517HandlerTable (HANDLER inHandler, OTHER_HANDLERS... inOtherHandlers) :
+  mHandler (inHandler),
+  mOtherHandlers (inOtherHandlers...) {
+  }
+
+//--- Returns false if there is no handler for filter inFilterIndex
+  public: inline bool handle (const uint32_t inFilterIndex, const CANMessage & inMessage) {
+    bool handled = true ;
+    if (inFilterIndex == 0) {
+      mHandler (inMessage) ;
+    }else{
+      handled = mOtherHandlers.handle (inFilterIndex - 1, inMessage) ;
+    }
+    return handled ;
+  }
+
+  private: HANDLER mHandler ;
+  private: ACAN2517HandlerTable <OTHER_HANDLERS...> mOtherHandlers ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  Factory (handler types are deduced)
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+template <typename... HANDLERS>
+ACAN2517HandlerTable <HANDLERS...> makeHandlerTable (HANDLERS... inHandlers) {
+  return ACAN2517HandlerTable <HANDLERS...> (inHandlers...) ;
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
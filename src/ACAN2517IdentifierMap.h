@@ -0,0 +1,219 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Open addressing hash table (linear probing), from CAN identifier to a 16-bit value. Storage is allocated once
+// by initWithCapacity; the table is never more than half full, so lookup is O(1) on average.
+// Keyed slots: a table that only uses slot (never insert or remove) maps identifiers to dense indexes
+// 0 ... count () - 1, that address parallel arrays of capacity () entries.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_IDENTIFIER_MAP_CLASS_DEFINED
+#define ACAN2517_IDENTIFIER_MAP_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <CANMessage.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517IdentifierMap class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517IdentifierMap {
+
+//······················································································································
+//   CONSTANT
+//······················································································································
+
+  public: static const uint16_t kNone = 0xFFFF ;
+
+//······················································································································
+//   KEY: identifier, bit 31 is set for an extended frame
+//······················································································································
+
+  public: static inline uint32_t key (const bool inExtended, const uint32_t inIdentifier) {
+    return inExtended ? (inIdentifier | (((uint32_t) 1) << 31)) : inIdentifier ;
+  }
+
+  public: static inline uint32_t key (const CANMessage & inMessage) {
+    return key (inMessage.ext, inMessage.id) ;
+  }
+
+//······················································································································
+//   IDENTIFIER CHECK
+//······················································································································
+
+  public: static inline uint32_t maxIdentifier (const tFrameFormat inFormat) {
+    return (inFormat == kExtended) ? 0x1FFFFFFF : 0x7FF ;
+  }
+
+  public: static inline bool validIdentifier (const tFrameFormat inFormat, const uint32_t inIdentifier) {
+    return inIdentifier <= maxIdentifier (inFormat) ;
+  }
+
+//······················································································································
+//   CONSTRUCTOR
+//······················································································································
+
+  public: ACAN2517IdentifierMap (void) {}
+
+//······················································································································
+//   DESTRUCTOR
+//······················································································································
+
+  public: ~ ACAN2517IdentifierMap (void) {
+    delete [] mKeys ;
+    delete [] mValues ;
+  }
+
+//······················································································································
+//   INIT
+//······················································································································
+
+  public: void initWithCapacity (const uint16_t inCapacity) {
+    uint8_t bits = 1 ;
+    while ((bits < 16) && ((((uint32_t) 1) << bits) < (2 * (uint32_t) inCapacity))) {
+      bits += 1 ;
+    }
+    const uint32_t tableSize = ((uint32_t) 1) << bits ;
+    mKeys = new uint32_t [tableSize] ;
+    mValues = new uint16_t [tableSize] ;
+    for (uint32_t i = 0 ; i < tableSize ; i++) {
+      mValues [i] = kNone ; // Empty
+    }
+    mShift = (uint8_t) (32 - bits) ;
+    mMask = (uint16_t) (tableSize - 1) ;
+    mCapacity = inCapacity ;
+    mCount = 0 ;
+  }
+
+//······················································································································
+//   ACCESSORS
+//······················································································································
+
+  public: uint16_t capacity (void) const { return mCapacity ; }
+
+  public: uint16_t count (void) const { return mCount ; }
+
+//······················································································································
+//   FIND (returns kNone if not found)
+//······················································································································
+
+  public: uint16_t find (const uint32_t inKey) const {
+    uint16_t result = kNone ;
+    if (mCount > 0) {
+      uint16_t i = home (inKey) ;
+      while ((mValues [i] != kNone) && (mKeys [i] != inKey)) {
+        i = (i + 1) & mMask ;
+      }
+      result = mValues [i] ;
+    }
+    return result ;
+  }
+
+//······················································································································
+//   INSERT (replaces the value if key exists; returns false if table is full)
+//······················································································································
+
+  public: bool insert (const uint32_t inKey, const uint16_t inValue) {
+    bool ok = false ;
+    if (mValues != NULL) {
+      uint16_t i = home (inKey) ;
+      while ((mValues [i] != kNone) && (mKeys [i] != inKey)) {
+        i = (i + 1) & mMask ;
+      }
+      ok = (mValues [i] != kNone) || (mCount < mCapacity) ;
+      if (ok) {
+        if (mValues [i] == kNone) {
+          mCount += 1 ;
+        }
+        mKeys [i] = inKey ;
+        mValues [i] = inValue ;
+      }
+    }
+    return ok ;
+  }
+
+//······················································································································
+//   KEYED SLOT: returns the index of the key, or assigns the next index (count ()) to a new key; returns kNone
+//   if the table is full
+//······················································································································
+
+  public: uint16_t slot (const uint32_t inKey) {
+    uint16_t index = find (inKey) ;
+    if (index == kNone) {
+      index = mCount ;
+      if (!insert (inKey, index)) {
+        index = kNone ;
+      }
+    }
+    return index ;
+  }
+
+//······················································································································
+//   REMOVE (backward shift deletion, no tombstone)
+//······················································································································
+
+  public: bool remove (const uint32_t inKey) {
+    bool found = false ;
+    if (mCount > 0) {
+      uint16_t i = home (inKey) ;
+      while ((mValues [i] != kNone) && (mKeys [i] != inKey)) {
+        i = (i + 1) & mMask ;
+      }
+      found = mValues [i] != kNone ;
+      if (found) {
+        mCount -= 1 ;
+        uint16_t hole = i ;
+        uint16_t j = (i + 1) & mMask ;
+        while (mValues [j] != kNone) {
+          const uint16_t h = home (mKeys [j]) ;
+        //--- Entry at j can fill the hole if its home is not within (hole, j]
+          const bool canMove = ((j - h) & mMask) >= ((j - hole) & mMask) ;
+          if (canMove) {
+            mKeys [hole] = mKeys [j] ;
+            mValues [hole] = mValues [j] ;
+            hole = j ;
+          }
+          j = (j + 1) & mMask ;
+        }
+        mValues [hole] = kNone ;
+      }
+    }
+    return found ;
+  }
+
+//······················································································································
+//   PRIVATE METHOD
+//······················································································································
+
+  private: inline uint16_t home (const uint32_t inKey) const {
+    return (uint16_t) ((inKey * (uint32_t) 2654435761UL) >> mShift) ;
+  }
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+  private: uint32_t * mKeys = NULL ;
+  private: uint16_t * mValues = NULL ; // kNone --> empty
+  private: uint8_t mShift = 31 ;
+  private: uint16_t mMask = 0 ;
+  private: uint16_t mCapacity = 0 ;
+  private: uint16_t mCount = 0 ;
+
+//······················································································································
+//   NO COPY
+//······················································································································
+
+  private: ACAN2517IdentifierMap (const ACAN2517IdentifierMap &) = delete ;
+  private: ACAN2517IdentifierMap & operator = (const ACAN2517IdentifierMap &) = delete ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
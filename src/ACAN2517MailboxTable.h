@@ -0,0 +1,131 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Mailbox table: every registered identifier has a slot holding its latest frame, written by receiveInterrupt
+// instead of being queued in the driver receive buffer. Every slot is protected by a sequence lock: the writer
+// makes the sequence odd while it updates the slot, a reader retries until it reads the same even sequence before
+// and after copying the frame. So reading needs no lock, and never blocks the writer.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_MAILBOX_TABLE_CLASS_DEFINED
+#define ACAN2517_MAILBOX_TABLE_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517IdentifierMap.h>
+#include <ACAN2517MemoryBarrier.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517MailboxTable class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517MailboxTable {
+
+//······················································································································
+//   EMBEDDED CLASS
+//······················································································································
+
+  private: class Slot {
+    public: volatile uint32_t mSequence = 0 ; // Odd while the slot is written; 2 * number of updates otherwise
+    public: CANMessage mMessage ;
+  } ;
+
+//······················································································································
+//   CONSTANT
+//······················································································································
+
+  public: static const uint16_t kNoMailbox = ACAN2517IdentifierMap::kNone ;
+
+//······················································································································
+//   CONSTRUCTOR
+//······················································································································
+
+  public: ACAN2517MailboxTable (void) {}
+
+//······················································································································
+//   DESTRUCTOR
+//······················································································································
+
+  public: ~ ACAN2517MailboxTable (void) {
+    delete [] mSlots ;
+  }
+
+//······················································································································
+//   INIT
+//······················································································································
+
+  public: void initWithSize (const uint16_t inCapacity) {
+    mMap.initWithCapacity (inCapacity) ;
+    mSlots = new Slot [inCapacity] ;
+  }
+
+//······················································································································
+//   REGISTER AN IDENTIFIER, returns its slot (kNoMailbox if there is no room left)
+//······················································································································
+
+  public: uint16_t add (const uint32_t inKey) {
+    return mMap.slot (inKey) ;
+  }
+
+//······················································································································
+//   WRITER (receiveInterrupt): find returns kNoMailbox if the identifier has no mailbox
+//······················································································································
+
+  public: inline uint16_t find (const CANMessage & inMessage) const {
+    return mMap.find (ACAN2517IdentifierMap::key (inMessage)) ;
+  }
+
+  public: inline void store (const uint16_t inSlot, const CANMessage & inMessage) {
+    Slot & slot = mSlots [inSlot] ;
+    slot.mSequence = slot.mSequence + 1 ; // Odd: update in progress
+    ACAN2517MemoryBarrier () ;
+    slot.mMessage = inMessage ;
+    ACAN2517MemoryBarrier () ;
+    slot.mSequence = slot.mSequence + 1 ; // Even: update done
+  }
+
+//······················································································································
+//   READER (lock free): returns false if no frame has been received yet. outSequence changes with every update.
+//······················································································································
+
+  public: bool read (const uint16_t inSlot, CANMessage & outMessage, uint32_t & outSequence) const {
+    bool received = false ;
+    if (inSlot < mMap.count ()) {
+      const Slot & slot = mSlots [inSlot] ;
+      bool retry = true ;
+      while (retry) {
+        const uint32_t sequence = slot.mSequence ;
+        ACAN2517MemoryBarrier () ;
+        outMessage = slot.mMessage ;
+        ACAN2517MemoryBarrier () ;
+        retry = ((sequence & 1) != 0) || (sequence != slot.mSequence) ;
+        outSequence = sequence ;
+      }
+      received = outSequence != 0 ;
+    }
+    return received ;
+  }
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+  private: ACAN2517IdentifierMap mMap ; // Identifier -> slot index
+  private: Slot * mSlots = NULL ;
+
+//······················································································································
+//   NO COPY
+//······················································································································
+
+  private: ACAN2517MailboxTable (const ACAN2517MailboxTable &) = delete ;
+  private: ACAN2517MailboxTable & operator = (const ACAN2517MailboxTable &) = delete ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
@@ -0,0 +1,28 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Memory barrier between receiveInterrupt and lock free readers (user receive ring, mailboxes). On ESP32,
+// receiveInterrupt runs in the driver handler task, the reader may run on the other core: a hardware barrier is
+// needed. Elsewhere, the writer is an interrupt service routine of the same core: a compiler barrier is enough.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_MEMORY_BARRIER_DEFINED
+#define ACAN2517_MEMORY_BARRIER_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+inline void ACAN2517MemoryBarrier (void) {
+  #ifdef ARDUINO_ARCH_ESP32
+    __sync_synchronize () ;
+  #else
+    __asm__ volatile ("" ::: "memory") ;
+  #endif
+}
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
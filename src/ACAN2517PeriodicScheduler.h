@@ -0,0 +1,189 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Periodic frames, kept in a hashed timing wheel (dates in milliseconds). This class only handles the
+// cadence; the ACAN2517::tick method sends the due frames.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_PERIODIC_SCHEDULER_CLASS_DEFINED
+#define ACAN2517_PERIODIC_SCHEDULER_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517EncodedFrame.h>
+#include <ACAN2517TimingWheel.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517PeriodicScheduler class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517PeriodicScheduler {
+
+//······················································································································
+//   CONSTANTS
+//······················································································································
+
+  public: static const uint16_t kNoPeriodicFrame = ACAN2517TimingWheel::kNone ;
+  public: static const uint32_t kAutomaticPhase = 0xFFFFFFFF ;
+
+//······················································································································
+//   EMBEDDED CLASS
+//······················································································································
+
+  private: class Entry {
+    public: ACAN2517EncodedFrame mFrame ;
+    public: uint32_t mPeriod = 0 ; // 0 --> entry is free
+    public: uint32_t mMissedDeadlineCount = 0 ;
+  } ;
+
+//······················································································································
+//   CONSTRUCTOR
+//······················································································································
+
+  public: ACAN2517PeriodicScheduler (void) {}
+
+//······················································································································
+//   DESTRUCTOR
+//······················································································································
+
+  public: ~ ACAN2517PeriodicScheduler (void) {
+    delete [] mEntryArray ;
+  }
+
+//······················································································································
+//   INIT (returns false if inWheelSize is not a power of 2)
+//······················································································································
+
+  public: bool initWithSize (const uint16_t inCapacity, const uint16_t inWheelSize, const uint32_t inNow) {
+    const bool ok = mWheel.initWithSize (inCapacity, inWheelSize, inNow) ;
+    if (ok) {
+      mEntryArray = new Entry [inCapacity] ;
+      mCapacity = inCapacity ;
+    }
+    return ok ;
+  }
+
+//······················································································································
+//   ADD A FRAME, returns its handle (kNoPeriodicFrame if no room, or period is 0)
+//   First transmission occurs at inNow + inPhase. kAutomaticPhase selects the phase (less than the period)
+//   whose wheel slot holds the fewest frames, spreading frames to avoid bursts.
+//······················································································································
+
+  public: uint16_t add (const ACAN2517EncodedFrame & inFrame,
+                        const uint32_t inPeriod,
+                        const uint32_t inPhase,
+                        const uint32_t inNow) {
+    uint16_t handle = kNoPeriodicFrame ;
+    for (uint16_t i = 0 ; (i < mCapacity) && (handle == kNoPeriodicFrame) && (inPeriod > 0) ; i++) {
+      if (mEntryArray [i].mPeriod == 0) {
+        handle = i ;
+      }
+    }
+    if (handle != kNoPeriodicFrame) {
+      uint32_t phase = inPhase ;
+      if (phase == kAutomaticPhase) {
+        const uint32_t candidateCount = (inPeriod < mWheel.slotCount ()) ? inPeriod : mWheel.slotCount () ;
+        phase = 0 ;
+        for (uint32_t candidate = 1 ; candidate < candidateCount ; candidate++) {
+          if (mWheel.slotLength (inNow + candidate) < mWheel.slotLength (inNow + phase)) {
+            phase = candidate ;
+          }
+        }
+      }
+      Entry & entry = mEntryArray [handle] ;
+      entry.mFrame = inFrame ;
+      entry.mPeriod = inPeriod ;
+      entry.mMissedDeadlineCount = 0 ;
+      mWheel.insert (handle, inNow + phase) ;
+    }
+    return handle ;
+  }
+
+//······················································································································
+//   REMOVE A FRAME
+//······················································································································
+
+  public: bool remove (const uint16_t inHandle) {
+    const bool ok = isValid (inHandle) ;
+    if (ok) {
+      mWheel.remove (inHandle) ;
+      mEntryArray [inHandle].mPeriod = 0 ;
+    }
+    return ok ;
+  }
+
+//······················································································································
+//   CHANGE FRAME CONTENTS (cadence is unchanged)
+//······················································································································
+
+  public: bool setFrame (const uint16_t inHandle, const ACAN2517EncodedFrame & inFrame) {
+    const bool ok = isValid (inHandle) ;
+    if (ok) {
+      mEntryArray [inHandle].mFrame = inFrame ;
+    }
+    return ok ;
+  }
+
+//······················································································································
+//   DUE FRAMES: startTick, then nextDue until it returns false; every returned frame should be rescheduled
+//······················································································································
+
+  public: void startTick (const uint32_t inNow) { mWheel.startExpiration (inNow) ; }
+
+  public: bool nextDue (uint16_t & outHandle) { return mWheel.nextExpired (outHandle) ; }
+
+//--- Returns the number of periods skipped because the tick came too late
+  public: uint32_t reschedule (const uint16_t inHandle, const uint32_t inNow) {
+    const Entry & entry = mEntryArray [inHandle] ;
+    const uint32_t due = mWheel.due (inHandle) ;
+    const uint32_t skipped = (inNow - due) / entry.mPeriod ;
+    mWheel.insert (inHandle, due + (skipped + 1) * entry.mPeriod) ;
+    return skipped ;
+  }
+
+  public: void addMissedDeadlines (const uint16_t inHandle, const uint32_t inCount) {
+    mEntryArray [inHandle].mMissedDeadlineCount += inCount ;
+    mMissedDeadlineCount += inCount ;
+  }
+
+//······················································································································
+//   ACCESSORS
+//······················································································································
+
+  public: bool isValid (const uint16_t inHandle) const {
+    return (inHandle < mCapacity) && (mEntryArray [inHandle].mPeriod > 0) ;
+  }
+
+  public: const ACAN2517EncodedFrame & frame (const uint16_t inHandle) const { return mEntryArray [inHandle].mFrame ; }
+
+  public: uint32_t missedDeadlineCount (const uint16_t inHandle) const {
+    return isValid (inHandle) ? mEntryArray [inHandle].mMissedDeadlineCount : 0 ;
+  }
+
+  public: uint32_t missedDeadlineCount (void) const { return mMissedDeadlineCount ; }
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+  private: ACAN2517TimingWheel mWheel ;
+  private: Entry * mEntryArray = NULL ;
+  private: uint16_t mCapacity = 0 ;
+  private: uint32_t mMissedDeadlineCount = 0 ;
+
+//······················································································································
+//   NO COPY
+//······················································································································
+
+  private: ACAN2517PeriodicScheduler (const ACAN2517PeriodicScheduler &) = delete ;
+  private: ACAN2517PeriodicScheduler & operator = (const ACAN2517PeriodicScheduler &) = delete ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
@@ -0,0 +1,171 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Raw receive buffer: with deferred decoding, receiveInterrupt appends controller receive message objects as read
+// from the SPI bus, they are decoded into CANMessage when they are removed. Storage is allocated once, by
+// initWithSize.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_RAW_BUFFER_CLASS_DEFINED
+#define ACAN2517_RAW_BUFFER_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <CANMessage.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517RawMessage class: receive message object (DS20005678B, page 42)
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517RawMessage {
+  public: uint32_t mIdentifierWord = 0 ; // R0: SID, EID (extended identifier bits are reordered by decode)
+  public: uint32_t mControlWord = 0 ; // R1: DLC, IDE, RTR, FILHIT
+  public: uint32_t mData32 [2] = {0, 0} ;
+
+//--- Filter index and data length, without decoding
+  public: inline uint8_t filterIndex (void) const {
+    return (uint8_t) ((mControlWord >> 11) & 0x1F) ;
+  }
+
+  public: inline uint8_t dataLength (void) const { // 0 for a remote frame
+    return ((mControlWord & (1 << 5)) != 0) ? 0 : length () ;
+  }
+
+//--- CAN 2.0B: DLC 9 ... 15 mean 8 data bytes
+  private: inline uint8_t length (void) const {
+    const uint8_t dlc = (uint8_t) (mControlWord & 0x0F) ;
+    return (dlc > 8) ? 8 : dlc ;
+  }
+
+//--- Decoding
+  public: inline void decode (CANMessage & outMessage) const {
+    outMessage.rtr = (mControlWord & (1 << 5)) != 0 ;
+    outMessage.ext = (mControlWord & (1 << 4)) != 0 ;
+    outMessage.len = length () ;
+    outMessage.idx = filterIndex () ;
+    outMessage.data32 [0] = mData32 [0] ;
+    outMessage.data32 [1] = mData32 [1] ;
+    if (outMessage.ext) { // Identifier bits sould be reordered (see DS20005678B, page 42)
+      outMessage.id = ((mIdentifierWord >> 11) & 0x3FFFF) | ((mIdentifierWord & 0x7FF) << 18) ;
+    }else{
+      outMessage.id = mIdentifierWord ;
+    }
+  }
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517RawBuffer class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517RawBuffer {
+
+//······················································································································
+//   CONSTRUCTOR
+//······················································································································
+
+  public: ACAN2517RawBuffer (void) {}
+
+//······················································································································
+//   DESTRUCTOR
+//······················································································································
+
+  public: ~ ACAN2517RawBuffer (void) {
+    delete [] mBuffer ;
+  }
+
+//······················································································································
+//   INIT
+//······················································································································
+
+  public: void initWithSize (const uint32_t inSize) {
+    mBuffer = new ACAN2517RawMessage [inSize] ;
+    mSize = inSize ;
+  }
+
+//······················································································································
+//   ACCESSORS
+//······················································································································
+
+  public: inline uint32_t size (void) const { return mSize ; }
+  public: inline uint32_t count (void) const { return mCount ; }
+  public: inline uint32_t peakCount (void) const { return mPeakCount ; }
+
+//······················································································································
+//   APPEND (receiveInterrupt)
+//······················································································································
+
+  public: inline bool append (const ACAN2517RawMessage & inMessage) {
+    const bool ok = mCount < mSize ;
+    if (ok) {
+      mBuffer [mWriteIndex] = inMessage ;
+      mWriteIndex += 1 ;
+      if (mWriteIndex == mSize) {
+        mWriteIndex = 0 ;
+      }
+      mCount += 1 ;
+      if (mPeakCount < mCount) {
+        mPeakCount = mCount ;
+      }
+    }
+    return ok ;
+  }
+
+//······················································································································
+//   DECODE HEAD (returns false if buffer is empty), CONSUME (returns the removed count)
+//······················································································································
+
+  public: inline bool decodeHead (CANMessage & outMessage) const {
+    const bool ok = mCount > 0 ;
+    if (ok) {
+      mBuffer [mReadIndex].decode (outMessage) ;
+    }
+    return ok ;
+  }
+
+  public: uint32_t consume (const uint32_t inCount) {
+    const uint32_t n = (inCount < mCount) ? inCount : mCount ;
+    mCount -= n ;
+    mReadIndex += n ;
+    if (mReadIndex >= mSize) {
+      mReadIndex -= mSize ;
+    }
+    return n ;
+  }
+
+//······················································································································
+//   REMOVE (decodes the message)
+//······················································································································
+
+  public: inline bool remove (CANMessage & outMessage) {
+    const bool ok = decodeHead (outMessage) ;
+    consume (1) ;
+    return ok ;
+  }
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+  private: ACAN2517RawMessage * mBuffer = NULL ;
+  private: uint32_t mSize = 0 ;
+  private: uint32_t mReadIndex = 0 ;
+  private: uint32_t mWriteIndex = 0 ;
+  private: uint32_t mCount = 0 ;
+  private: uint32_t mPeakCount = 0 ;
+
+//······················································································································
+//   NO COPY
+//······················································································································
+
+  private: ACAN2517RawBuffer (const ACAN2517RawBuffer &) = delete ;
+  private: ACAN2517RawBuffer & operator = (const ACAN2517RawBuffer &) = delete ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
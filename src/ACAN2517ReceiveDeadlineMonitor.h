@@ -0,0 +1,153 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Receive deadline monitor: every monitored identifier has a time out (in ms); each reception of the identifier
+// re-arms its deadline in a timing wheel. Checking deadlines only visits the wheel slots of elapsed milliseconds.
+// An expired identifier is flagged until it is received again.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_RECEIVE_DEADLINE_MONITOR_CLASS_DEFINED
+#define ACAN2517_RECEIVE_DEADLINE_MONITOR_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517IdentifierMap.h>
+#include <ACAN2517TimingWheel.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517ReceiveDeadlineMonitor class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517ReceiveDeadlineMonitor {
+
+//······················································································································
+//   CONSTANT
+//······················································································································
+
+  public: static const uint16_t kNoMonitoredFrame = ACAN2517IdentifierMap::kNone ;
+
+//······················································································································
+//   CONSTRUCTOR
+//······················································································································
+
+  public: ACAN2517ReceiveDeadlineMonitor (void) {}
+
+//······················································································································
+//   DESTRUCTOR
+//······················································································································
+
+  public: ~ ACAN2517ReceiveDeadlineMonitor (void) {
+    delete [] mTimeOut ;
+    delete [] mExpiredFlags ;
+  }
+
+//······················································································································
+//   INIT (returns false if inWheelSize is not a power of 2)
+//······················································································································
+
+  public: bool initWithSize (const uint16_t inCapacity, const uint16_t inWheelSize, const uint32_t inNow) {
+    const bool ok = mWheel.initWithSize (inCapacity, inWheelSize, inNow) ;
+    if (ok) {
+      mMap.initWithCapacity (inCapacity) ;
+      mTimeOut = new uint32_t [inCapacity] ;
+      const uint16_t wordCount = (inCapacity + 31) / 32 ;
+      mExpiredFlags = new uint32_t [wordCount] ;
+      for (uint16_t i = 0 ; i < wordCount ; i++) {
+        mExpiredFlags [i] = 0 ;
+      }
+    }
+    return ok ;
+  }
+
+//······················································································································
+//   ADD AN IDENTIFIER, returns its index (kNoMonitoredFrame if no room); deadline is armed at once
+//······················································································································
+
+  public: uint16_t add (const uint32_t inKey, const uint32_t inTimeOut, const uint32_t inNow) {
+    const uint16_t index = mMap.slot (inKey) ;
+    if (index != kNoMonitoredFrame) {
+      mTimeOut [index] = inTimeOut ;
+      refreshIndex (index, inNow) ;
+    }
+    return index ;
+  }
+
+//······················································································································
+//   REFRESH (on reception), O(1)
+//······················································································································
+
+  public: inline void refresh (const uint32_t inKey, const uint32_t inNow) {
+    const uint16_t index = mMap.find (inKey) ;
+    if (index != kNoMonitoredFrame) {
+      refreshIndex (index, inNow) ;
+    }
+  }
+
+//······················································································································
+//   CHECK: startCheck, then nextExpired until it returns false; every returned index is flagged as expired
+//······················································································································
+
+  public: void startCheck (const uint32_t inNow) { mWheel.startExpiration (inNow) ; }
+
+  public: bool nextExpired (uint16_t & outIndex) {
+    const bool found = mWheel.nextExpired (outIndex) ;
+    if (found) {
+      mExpiredFlags [outIndex / 32] |= ((uint32_t) 1) << (outIndex % 32) ;
+      mExpirationCount += 1 ;
+    }
+    return found ;
+  }
+
+//······················································································································
+//   ACCESSORS
+//······················································································································
+
+  public: uint16_t count (void) const { return mMap.count () ; }
+
+  public: bool isExpired (const uint16_t inIndex) const {
+    return (inIndex < mMap.count ()) && ((mExpiredFlags [inIndex / 32] & (((uint32_t) 1) << (inIndex % 32))) != 0) ;
+  }
+
+//--- Flags of indexes 32 * inWordIndex ... 32 * inWordIndex + 31
+  public: uint32_t expiredFlags (const uint16_t inWordIndex) const {
+    return (inWordIndex < ((mMap.count () + 31) / 32)) ? mExpiredFlags [inWordIndex] : 0 ;
+  }
+
+  public: uint32_t expirationCount (void) const { return mExpirationCount ; }
+
+//······················································································································
+//   PRIVATE METHOD
+//······················································································································
+
+  private: inline void refreshIndex (const uint16_t inIndex, const uint32_t inNow) {
+    mWheel.remove (inIndex) ;
+    mWheel.insert (inIndex, inNow + mTimeOut [inIndex]) ;
+    mExpiredFlags [inIndex / 32] &= ~ (((uint32_t) 1) << (inIndex % 32)) ;
+  }
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+  private: ACAN2517IdentifierMap mMap ; // Identifier -> index
+  private: ACAN2517TimingWheel mWheel ;
+  private: uint32_t * mTimeOut = NULL ;
+  private: uint32_t * mExpiredFlags = NULL ;
+  private: uint32_t mExpirationCount = 0 ;
+
+//······················································································································
+//   NO COPY
+//······················································································································
+
+  private: ACAN2517ReceiveDeadlineMonitor (const ACAN2517ReceiveDeadlineMonitor &) = delete ;
+  private: ACAN2517ReceiveDeadlineMonitor & operator = (const ACAN2517ReceiveDeadlineMonitor &) = delete ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
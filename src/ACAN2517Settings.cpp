@@ -178,6 +178,10 @@ uint32_t ACAN2517Settings::ramUsage (void) const {
   result += 16 * mControllerReceiveFIFOSize ;
 //--- Send FIFO (FIFO #2)
   result += 16 * mControllerTransmitFIFOSize ;
+//--- Resident transmit FIFOs (FIFO #3, ...), one message each
+  result += 16 * mControllerResidentTransmitFIFOCount ;
+//--- Immediate receive FIFO (after resident transmit FIFOs)
+  result += 16 * mControllerImmediateReceiveFIFOSize ;
 //---
   return result ;
 }
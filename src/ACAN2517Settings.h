@@ -52,6 +52,12 @@ class ACAN2517Settings {
     UnlimitedNumber
   } RetransmissionAttempts ;
 
+  public: typedef enum : uint8_t {
+    Backpressure, // Messages are left in controller receive FIFO, that may overflow
+    DropOldest,
+    DropNewest
+  } ReceiveOverflowPolicy ;
+
 //······················································································································
 //   CONSTRUCTOR
 //······················································································································
@@ -128,6 +134,19 @@ class ACAN2517Settings {
   public: RetransmissionAttempts mControllerTXQBufferRetransmissionAttempts = UnlimitedNumber ;
 
 
+//······················································································································
+//   RESIDENT TRANSMIT FIFOS
+//······················································································································
+
+//--- Number of single message transmit FIFOs holding a controller resident frame (FIFO #3, #4, ...)
+  public: uint8_t mControllerResidentTransmitFIFOCount = 0 ; // 0 ... 29
+
+//--- Resident transmit FIFOs priority (0 --> lowest, 31 --> highest)
+  public: uint8_t mControllerResidentTransmitFIFOPriority = 0 ; // 0 ... 31
+
+//--- Resident transmit FIFOs retransmission attempts
+  public: RetransmissionAttempts mControllerResidentTransmitFIFORetransmissionAttempts = UnlimitedNumber ;
+
 //······················································································································
 //   RECEIVE FIFO
 //······················································································································
@@ -138,6 +157,104 @@ class ACAN2517Settings {
 //--- Controller receive FIFO size
   public: uint8_t mControllerReceiveFIFOSize = 32 ; // 1 ... 32
 
+//--- Controller receive FIFO of the immediate filters (the FIFO after the resident transmit FIFOs): it is served
+//    by the interrupt service routine even while the driver receive buffer is full. 0 --> immediate filters use
+//    the receive FIFO (FIFO #1)
+  public: uint8_t mControllerImmediateReceiveFIFOSize = 4 ; // 0 ... 32
+
+//--- What receiveInterrupt does when the driver receive buffer is full; a user receive ring is written by the
+//    driver at its write index only, so DropOldest behaves as DropNewest for it. With DropOldest, the oldest
+//    message may be overwritten while it is processed in place: so peek returns a copy of it, peekContiguous
+//    returns at most one message, and consume does not remove again the messages dropped since the last peek.
+  public: ReceiveOverflowPolicy mDriverReceiveOverflowPolicy = Backpressure ;
+
+//--- Deferred decoding: the driver receive buffer holds controller message objects as read by receiveInterrupt,
+//    they are decoded when they are received. Messages are decoded by receiveInterrupt only if the receive
+//    pipeline needs them (deny list, content filter, change only, decimation, mailboxes, deadline monitor)
+  public: bool mDeferredReceiveDecoding = false ;
+
+//······················································································································
+//   PERIODIC TRANSMIT SCHEDULER
+//······················································································································
+
+//--- Maximum number of periodic frames (0 --> no scheduler)
+  public: uint16_t mPeriodicFrameCapacity = 0 ;
+
+//--- Timing wheel size, in milliseconds (should be a power of 2)
+  public: uint16_t mPeriodicSchedulerWheelSize = 64 ;
+
+//······················································································································
+//   RECEIVE DEADLINE MONITOR
+//······················································································································
+
+//--- Maximum number of monitored identifiers (0 --> no monitor)
+  public: uint16_t mReceiveDeadlineCapacity = 0 ;
+
+//--- Timing wheel size, in milliseconds (should be a power of 2)
+  public: uint16_t mReceiveDeadlineWheelSize = 64 ;
+
+//······················································································································
+//   SOFTWARE DISPATCH TABLE (for frames accepted by a hardware filter without call back routine)
+//······················································································································
+
+//--- Maximum number of exact identifier entries
+  public: uint16_t mSoftwareFrameFilterCapacity = 0 ;
+
+//--- Maximum number of mask / acceptance entries
+  public: uint8_t mSoftwareMaskFilterCapacity = 0 ;
+
+//······················································································································
+//   FILTER STATISTICS (frame and byte counts per hardware filter, 256 bytes of RAM)
+//······················································································································
+
+  public: bool mFilterStatistics = false ;
+
+//······················································································································
+//   DENY LIST (denied frames are dropped by the interrupt service routine, they never enter the driver
+//   receive buffer)
+//······················································································································
+
+//--- Standard identifiers can be denied (256 bytes bitmap)
+  public: bool mStandardDenyList = false ;
+
+//--- Maximum number of denied extended identifiers (0 --> none)
+  public: uint16_t mExtendedDenyListCapacity = 0 ;
+
+//······················································································································
+//   CONTENT FILTER (frames whose data do not match are dropped by the interrupt service routine)
+//······················································································································
+
+//--- Maximum number of rules (0 --> no content filter)
+  public: uint8_t mContentFilterCapacity = 0 ;
+
+//······················································································································
+//   CHANGE ONLY DELIVERY (repeated frames of registered identifiers are dropped by the interrupt service routine)
+//······················································································································
+
+//--- Maximum number of registered identifiers (0 --> none)
+  public: uint16_t mChangeOnlyCapacity = 0 ;
+
+//······················································································································
+//   RECEIVE DECIMATION (frames of registered identifiers are decimated by the interrupt service routine)
+//······················································································································
+
+//--- Maximum number of registered identifiers (0 --> none)
+  public: uint16_t mDecimationCapacity = 0 ;
+
+//······················································································································
+//   MAILBOXES (latest frame of registered identifiers, instead of the driver receive buffer)
+//······················································································································
+
+//--- Maximum number of mailboxes (0 --> none); every mailbox uses about 32 bytes of RAM
+  public: uint16_t mMailboxCapacity = 0 ;
+
+//······················································································································
+//   ESP32 HANDLER TASK (runs isr_core and tick; immediate filter call backs and tick call backs run in it)
+//······················································································································
+
+//--- Stack size of the handler task, in bytes (ESP32 only)
+  public: uint16_t mESP32HandlerTaskStackSize = 4096 ;
+
 //······················································································································
 //    SYSCLOCK frequency computation
 //······················································································································
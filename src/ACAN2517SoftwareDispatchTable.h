@@ -0,0 +1,174 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Software dispatch table, consulted by dispatchReceivedMessage for frames accepted by a hardware filter without
+// call back routine: exact identifiers are found in an open addressing hash table (O(1) on average), then mask
+// rules are tried in order. Storage is allocated once, by initWithSize. Hits of exact identifiers are counted by
+// receiveInterrupt (countHit), for adaptive filter placement.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_SOFTWARE_DISPATCH_TABLE_CLASS_DEFINED
+#define ACAN2517_SOFTWARE_DISPATCH_TABLE_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <ACAN2517IdentifierMap.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517SoftwareDispatchTable class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517SoftwareDispatchTable {
+
+//······················································································································
+//   EMBEDDED CLASS
+//······················································································································
+
+  private: class MaskRule {
+    public: uint32_t mMask = 0 ; // Identifier map keys
+    public: uint32_t mAcceptance = 0 ;
+    public: ACANCallBackRoutine mCallBackRoutine = NULL ;
+  } ;
+
+//······················································································································
+//   CONSTRUCTOR
+//······················································································································
+
+  public: ACAN2517SoftwareDispatchTable (void) {}
+
+//······················································································································
+//   DESTRUCTOR
+//······················································································································
+
+  public: ~ ACAN2517SoftwareDispatchTable (void) {
+    delete [] mFrameCallBacks ;
+    delete [] mFrameKeys ;
+    delete [] mFrameHitCounts ;
+    delete [] mMaskRules ;
+  }
+
+//······················································································································
+//   INIT
+//······················································································································
+
+  public: void initWithSize (const uint16_t inFrameCapacity, const uint8_t inMaskRuleCapacity) {
+    mFrameMap.initWithCapacity (inFrameCapacity) ;
+    mFrameCallBacks = new ACANCallBackRoutine [inFrameCapacity] ;
+    mFrameKeys = new uint32_t [inFrameCapacity] ;
+    mFrameHitCounts = new uint32_t [inFrameCapacity] ;
+    mMaskRules = new MaskRule [inMaskRuleCapacity] ;
+    mMaskRuleCapacity = inMaskRuleCapacity ;
+  }
+
+//······················································································································
+//   APPEND (returns false if there is no room left)
+//······················································································································
+
+  public: bool appendFrame (const uint32_t inKey, const ACANCallBackRoutine inCallBackRoutine) {
+    const uint16_t index = mFrameMap.slot (inKey) ;
+    const bool ok = index != ACAN2517IdentifierMap::kNone ;
+    if (ok) {
+      mFrameCallBacks [index] = inCallBackRoutine ;
+      mFrameKeys [index] = inKey ;
+      mFrameHitCounts [index] = 0 ;
+    }
+    return ok ;
+  }
+
+//······················································································································
+
+  public: bool appendMaskRule (const uint32_t inMask,
+                               const uint32_t inAcceptance,
+                               const ACANCallBackRoutine inCallBackRoutine) {
+    const bool ok = mMaskRuleCount < mMaskRuleCapacity ;
+    if (ok) {
+      MaskRule & rule = mMaskRules [mMaskRuleCount] ;
+      rule.mMask = inMask ;
+      rule.mAcceptance = inAcceptance & inMask ;
+      rule.mCallBackRoutine = inCallBackRoutine ;
+      mMaskRuleCount += 1 ;
+    }
+    return ok ;
+  }
+
+//······················································································································
+//   LOOKUP (returns NULL if no entry matches)
+//······················································································································
+
+  public: ACANCallBackRoutine callBack (const CANMessage & inMessage) {
+    const uint32_t key = ACAN2517IdentifierMap::key (inMessage) ;
+    const uint16_t index = mFrameMap.find (key) ;
+    ACANCallBackRoutine result = NULL ;
+    if (index != ACAN2517IdentifierMap::kNone) {
+      result = mFrameCallBacks [index] ;
+    }
+    for (uint8_t i = 0 ; (i < mMaskRuleCount) && (result == NULL) ; i++) {
+      if ((key & mMaskRules [i].mMask) == mMaskRules [i].mAcceptance) {
+        result = mMaskRules [i].mCallBackRoutine ;
+      }
+    }
+    if (result == NULL) {
+      mRejectedFrameCount += 1 ;
+    }
+    return result ;
+  }
+
+//······················································································································
+//   EXACT IDENTIFIER ENTRIES (index: 0 ... frameCount () - 1)
+//······················································································································
+
+  public: uint16_t frameCount (void) const { return mFrameMap.count () ; }
+
+  public: uint16_t frameCapacity (void) const { return mFrameMap.capacity () ; }
+
+  public: uint32_t frameKey (const uint16_t inIndex) const { return mFrameKeys [inIndex] ; }
+
+  public: uint32_t frameHitCount (const uint16_t inIndex) const { return mFrameHitCounts [inIndex] ; }
+
+//--- Called by receiveInterrupt, for every frame accepted by an adaptive filter, even if it is not dispatched
+  public: inline void countHit (const CANMessage & inMessage) {
+    const uint16_t index = mFrameMap.find (ACAN2517IdentifierMap::key (inMessage)) ;
+    if (index != ACAN2517IdentifierMap::kNone) {
+      mFrameHitCounts [index] += 1 ;
+    }
+  }
+
+//--- Hit counts are halved, so they follow the recent traffic
+  public: void decayFrameHitCounts (void) {
+    for (uint16_t i = 0 ; i < mFrameMap.count () ; i++) {
+      mFrameHitCounts [i] /= 2 ;
+    }
+  }
+
+//--- Frames without call back routine (neither an exact identifier, nor a mask rule)
+  public: uint32_t rejectedFrameCount (void) const { return mRejectedFrameCount ; }
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+  private: ACAN2517IdentifierMap mFrameMap ; // Identifier -> index in mFrameCallBacks
+  private: ACANCallBackRoutine * mFrameCallBacks = NULL ;
+  private: uint32_t * mFrameKeys = NULL ;
+  private: uint32_t * mFrameHitCounts = NULL ;
+  private: uint32_t mRejectedFrameCount = 0 ;
+  private: MaskRule * mMaskRules = NULL ;
+  private: uint8_t mMaskRuleCapacity = 0 ;
+  private: uint8_t mMaskRuleCount = 0 ;
+
+//······················································································································
+//   NO COPY
+//······················································································································
+
+  private: ACAN2517SoftwareDispatchTable (const ACAN2517SoftwareDispatchTable &) = delete ;
+  private: ACAN2517SoftwareDispatchTable & operator = (const ACAN2517SoftwareDispatchTable &) = delete ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
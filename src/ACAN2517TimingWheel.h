@@ -0,0 +1,209 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Hashed timing wheel: entry i (0 ... entryCount-1) is due at an absolute date (any time unit, wrap around safe);
+// it is linked in slot (date & (slotCount-1)). Expiring entries only visits the slots of elapsed dates, so the
+// cost is proportional to the number of entries in those slots, not to the number of entries.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_TIMING_WHEEL_CLASS_DEFINED
+#define ACAN2517_TIMING_WHEEL_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <Arduino.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517TimingWheel class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517TimingWheel {
+
+//······················································································································
+//   CONSTANT
+//······················································································································
+
+  public: static const uint16_t kNone = 0xFFFF ;
+
+//······················································································································
+//   CONSTRUCTOR
+//······················································································································
+
+  public: ACAN2517TimingWheel (void) {}
+
+//······················································································································
+//   DESTRUCTOR
+//······················································································································
+
+  public: ~ ACAN2517TimingWheel (void) {
+    delete [] mSlotHead ;
+    delete [] mSlotLength ;
+    delete [] mNext ;
+    delete [] mPrevious ;
+    delete [] mSlot ;
+    delete [] mDue ;
+  }
+
+//······················································································································
+//   INIT (inSlotCount should be a power of 2; returns false if not)
+//······················································································································
+
+  public: bool initWithSize (const uint16_t inEntryCount, const uint16_t inSlotCount, const uint32_t inNow) {
+    const bool ok = (inSlotCount > 0) && ((inSlotCount & (inSlotCount - 1)) == 0) && (inEntryCount < kNone) ;
+    if (ok) {
+      mSlotHead = new uint16_t [inSlotCount] ;
+      mSlotLength = new uint16_t [inSlotCount] ;
+      for (uint16_t i = 0 ; i < inSlotCount ; i++) {
+        mSlotHead [i] = kNone ;
+        mSlotLength [i] = 0 ;
+      }
+      mNext = new uint16_t [inEntryCount] ;
+      mPrevious = new uint16_t [inEntryCount] ;
+      mSlot = new uint16_t [inEntryCount] ;
+      mDue = new uint32_t [inEntryCount] ;
+      for (uint16_t i = 0 ; i < inEntryCount ; i++) {
+        mSlot [i] = kNone ; // Not linked
+      }
+      mSlotMask = inSlotCount - 1 ;
+      mEntryCount = inEntryCount ;
+      mCurrentDate = inNow ;
+    }
+    return ok ;
+  }
+
+//······················································································································
+//   ACCESSORS
+//······················································································································
+
+  public: uint16_t slotCount (void) const { return mSlotMask + 1 ; }
+
+  public: uint16_t entryCount (void) const { return mEntryCount ; }
+
+  public: uint32_t currentDate (void) const { return mCurrentDate ; }
+
+  public: bool isLinked (const uint16_t inEntry) const { return mSlot [inEntry] != kNone ; }
+
+  public: uint32_t due (const uint16_t inEntry) const { return mDue [inEntry] ; }
+
+  public: uint16_t slotLength (const uint32_t inDate) const { return mSlotLength [inDate & mSlotMask] ; }
+
+//······················································································································
+//   INSERT (entry should not be linked). A date not after current date is handled by next expiration.
+//······················································································································
+
+  public: void insert (const uint16_t inEntry, const uint32_t inDue) {
+    const bool late = (int32_t) (inDue - mCurrentDate) <= 0 ;
+    const uint16_t slot = (late ? (mCurrentDate + 1) : inDue) & mSlotMask ;
+    mDue [inEntry] = inDue ;
+    mSlot [inEntry] = slot ;
+    mPrevious [inEntry] = kNone ;
+    mNext [inEntry] = mSlotHead [slot] ;
+    if (mSlotHead [slot] != kNone) {
+      mPrevious [mSlotHead [slot]] = inEntry ;
+    }
+    mSlotHead [slot] = inEntry ;
+    mSlotLength [slot] += 1 ;
+  }
+
+//······················································································································
+//   REMOVE (does nothing if entry is not linked)
+//······················································································································
+
+  public: void remove (const uint16_t inEntry) {
+    const uint16_t slot = mSlot [inEntry] ;
+    if (slot != kNone) {
+      if (mCursor == inEntry) {
+        mCursor = mNext [inEntry] ;
+      }
+      if (mPrevious [inEntry] == kNone) {
+        mSlotHead [slot] = mNext [inEntry] ;
+      }else{
+        mNext [mPrevious [inEntry]] = mNext [inEntry] ;
+      }
+      if (mNext [inEntry] != kNone) {
+        mPrevious [mNext [inEntry]] = mPrevious [inEntry] ;
+      }
+      mSlot [inEntry] = kNone ;
+      mSlotLength [slot] -= 1 ;
+    }
+  }
+
+//······················································································································
+//   EXPIRATION
+//   startExpiration (now) sets the current date to now; then, every call of nextExpired removes and returns an
+//   entry due at or before now, until it returns false. Entries can be inserted or removed between two calls,
+//   but an entry inserted during expiration should be due after now.
+//······················································································································
+
+  public: void startExpiration (const uint32_t inNow) {
+    const uint32_t elapsed = inNow - mCurrentDate ;
+    mSlotsToVisit = ((int32_t) elapsed <= 0) ? 0 : ((elapsed > mSlotMask) ? (mSlotMask + 1) : elapsed) ;
+    mVisitedDate = mCurrentDate ;
+    mExpirationDate = inNow ;
+    mCursor = kNone ;
+    if ((int32_t) elapsed > 0) {
+      mCurrentDate = inNow ;
+    }
+  }
+
+//······················································································································
+
+  public: bool nextExpired (uint16_t & outEntry) {
+    bool found = false ;
+    bool loop = true ;
+    while (loop) {
+      while ((mCursor == kNone) && (mSlotsToVisit > 0)) {
+        mVisitedDate += 1 ;
+        mSlotsToVisit -= 1 ;
+        mCursor = mSlotHead [mVisitedDate & mSlotMask] ;
+      }
+      loop = mCursor != kNone ;
+      if (loop) {
+        const uint16_t entry = mCursor ;
+        mCursor = mNext [entry] ;
+        if ((int32_t) (mDue [entry] - mExpirationDate) <= 0) {
+          remove (entry) ;
+          outEntry = entry ;
+          found = true ;
+          loop = false ;
+        }
+      }
+    }
+    return found ;
+  }
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+  private: uint16_t * mSlotHead = NULL ;
+  private: uint16_t * mSlotLength = NULL ;
+  private: uint16_t * mNext = NULL ;
+  private: uint16_t * mPrevious = NULL ;
+  private: uint16_t * mSlot = NULL ; // kNone --> entry not linked
+  private: uint32_t * mDue = NULL ;
+  private: uint16_t mSlotMask = 0 ;
+  private: uint16_t mEntryCount = 0 ;
+  private: uint32_t mCurrentDate = 0 ;
+//--- Expiration state
+  private: uint32_t mVisitedDate = 0 ;
+  private: uint32_t mExpirationDate = 0 ;
+  private: uint16_t mSlotsToVisit = 0 ;
+  private: uint16_t mCursor = kNone ;
+
+//······················································································································
+//   NO COPY
+//······················································································································
+
+  private: ACAN2517TimingWheel (const ACAN2517TimingWheel &) = delete ;
+  private: ACAN2517TimingWheel & operator = (const ACAN2517TimingWheel &) = delete ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
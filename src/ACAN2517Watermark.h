@@ -0,0 +1,85 @@
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+// An utility class for:
+//   - ACAN2517 CAN driver for MCP2517FD (CAN 2.0B mode)
+// by Pierre Molinaro
+// https://github.com/pierremolinaro/acan2517
+//
+// Buffer watermark: the call back is called with true when the buffer count reaches the high watermark, and with
+// false when it then falls to the low watermark. So a producer or a consumer is notified once per crossing,
+// instead of polling the buffer count.
+//
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifndef ACAN2517_WATERMARK_CLASS_DEFINED
+#define ACAN2517_WATERMARK_CLASS_DEFINED
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <Arduino.h>
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//  ACAN2517Watermark class
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+class ACAN2517Watermark {
+
+//······················································································································
+//   CALL BACK TYPE
+//······················································································································
+
+  public: typedef void (*tCallBack) (const bool inHighWatermarkReached) ;
+
+//······················································································································
+//   CONSTRUCTOR
+//······················································································································
+
+  public: ACAN2517Watermark (void) {}
+
+//······················································································································
+//   SETTING (inCallBack == NULL --> disabled; inLowWatermark should be lower than inHighWatermark)
+//······················································································································
+
+  public: void set (const uint32_t inHighWatermark, const uint32_t inLowWatermark, const tCallBack inCallBack) {
+    mHighWatermark = inHighWatermark ;
+    mLowWatermark = inLowWatermark ;
+    mCallBack = inCallBack ;
+    mHigh = false ;
+  }
+
+//······················································································································
+//   UPDATE (called every time the buffer count changes)
+//······················································································································
+
+  public: inline void update (const uint32_t inCount) {
+    if (mCallBack != NULL) {
+      if (!mHigh && (inCount >= mHighWatermark)) {
+        mHigh = true ;
+        mCallBack (true) ;
+      }else if (mHigh && (inCount <= mLowWatermark)) {
+        mHigh = false ;
+        mCallBack (false) ;
+      }
+    }
+  }
+
+//······················································································································
+//   PRIVATE PROPERTIES
+//······················································································································
+
+  private: tCallBack mCallBack = NULL ;
+  private: uint32_t mHighWatermark = 0 ;
+  private: uint32_t mLowWatermark = 0 ;
+  private: bool mHigh = false ; // true from high watermark crossing to low watermark crossing
+
+//······················································································································
+//   NO COPY
+//······················································································································
+
+  private: ACAN2517Watermark (const ACAN2517Watermark &) = delete ;
+  private: ACAN2517Watermark & operator = (const ACAN2517Watermark &) = delete ;
+
+} ;
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#endif
@@ -109,6 +109,30 @@ class ACANBuffer {
     return ok ;
   }
 
+//······················································································································
+// In place access: head returns NULL if buffer is empty; contiguousCount is the number of messages from head
+// up to the end of the buffer storage; consume removes up to inCount messages, returns the removed count
+//······················································································································
+
+  public: inline const CANMessage * head (void) const {
+    return (mCount > 0) ? & mBuffer [mReadIndex] : NULL ;
+  }
+
+  public: inline uint32_t contiguousCount (void) const {
+    const uint32_t countToEnd = mSize - mReadIndex ;
+    return (mCount < countToEnd) ? mCount : countToEnd ;
+  }
+
+  public: uint32_t consume (const uint32_t inCount) {
+    const uint32_t n = (inCount < mCount) ? inCount : mCount ;
+    mCount -= n ;
+    mReadIndex += n ;
+    if (mReadIndex >= mSize) {
+      mReadIndex -= mSize ;
+    }
+    return n ;
+  }
+
 //······················································································································
 // No copy
 //······················································································································